@@ -32,6 +32,64 @@
 extern InputImpl *inputImpl;
 extern PortsImpl *portsImpl;
 
+static inline channelValue_t adcInvert( uint8_t ch, channelValue_t v) {
+
+#ifdef INVERT_CH1
+    if( ch == 0) v = ADC_RESOLUTION -v;
+#endif
+#ifdef INVERT_CH2
+    if( ch == 1) v = ADC_RESOLUTION -v;
+#endif
+#ifdef INVERT_CH3
+    if( ch == 2) v = ADC_RESOLUTION -v;
+#endif
+#ifdef INVERT_CH4
+    if( ch == 3) v = ADC_RESOLUTION -v;
+#endif
+
+    return v;
+}
+
+#ifdef ENABLE_ADC_OVERSAMPLING
+
+/* 
+ * ADC conversion complete interrupt.
+ *
+ * The ADC is free running and cycles through all channels.
+ * After ADC_OVERSAMPLING passes the averaged values are published.
+ */
+ISR(ADC_vect) {
+
+    /* MUST read ADCL first */
+    channelValue_t v = ADCL;
+    v |= (ADCH << 8);
+
+    uint8_t ch = inputImpl->mux;
+    uint8_t running = inputImpl->nextMux;
+
+    /* ch >= adcInputs: Discard first conversion after start */
+    if( ch < inputImpl->adcInputs) {
+        inputImpl->adcSum[ch] += v;
+
+        if( ch == inputImpl->adcInputs -1 && ++inputImpl->pass >= ADC_OVERSAMPLING) {
+            inputImpl->publish();
+            inputImpl->pass = 0;
+        }
+    }
+
+    /* The conversion in progress uses the previous selection.
+     * Select the channel for the conversion after that.
+     */
+    inputImpl->mux = running;
+    if( ++running >= inputImpl->adcInputs) {
+        running = 0;
+    }
+    inputImpl->nextMux = running;
+    inputImpl->selectChannel( running);
+}
+
+#else
+
 /* 
  * ADC conversion complete interrupt. 
  */
@@ -46,28 +104,26 @@ ISR(ADC_vect) {
     
     if( inputImpl->mux < inputImpl->adcInputs) {
 
-#ifdef INVERT_CH1
-      if( inputImpl->mux == 0) v = ADC_RESOLUTION -v;
-#endif
-#ifdef INVERT_CH2
-      if( inputImpl->mux == 1) v = ADC_RESOLUTION -v;
-#endif
-#ifdef INVERT_CH3
-      if( inputImpl->mux == 2) v = ADC_RESOLUTION -v;
-#endif
-#ifdef INVERT_CH4
-      if( inputImpl->mux == 3) v = ADC_RESOLUTION -v;
-#endif
-
-      inputImpl->adcValues[inputImpl->mux] = v;
+      inputImpl->adcValues[inputImpl->mux] = adcInvert( inputImpl->mux, v);
       
       inputImpl->mux++;
+      if( inputImpl->mux == inputImpl->adcInputs) {
+#ifdef ENABLE_LATENCY_STATISTICS
+          inputImpl->adcValuesTime_usec = micros();
+#endif
+#ifdef ENABLE_JIT_SCHEDULING
+          /* The scheduler waits for this sequence. Publish it right away. */
+          inputImpl->swapSnapshot();
+#endif
+      }
       inputImpl->setMux();      
     } else {
       /* done */
     }
 }
 
+#endif
+
 InputImpl::InputImpl( channel_t stickCnt, channel_t trimCnt, channel_t auxCnt,
                       const uint8_t analogPins[],
                       switch_t switches, const switchConf_t *conf,
@@ -83,11 +139,48 @@ InputImpl::InputImpl( channel_t stickCnt, channel_t trimCnt, channel_t auxCnt,
     this->switchPins = switchPins;
 
     adcValues = new channelValue_t[adcInputs];
+    adcSnapshot = new channelValue_t[adcInputs];
+
+    for( int i=0; i<adcInputs; i++) {
+        adcValues[i] = adcSnapshot[i] = 0;
+    }
+
+    /* No conversion running */
+    mux = adcInputs;
+
+#ifdef ENABLE_ADC_OVERSAMPLING
+    adcSum = new uint16_t[adcInputs];
 
     for( int i=0; i<adcInputs; i++) {
-        adcValues[i] = 0;
+        adcSum[i] = 0;
     }
 
+    nextMux = 0;
+    pass = 0;
+#endif
+
+#ifdef ENABLE_SWITCH_SCANNER
+    switchBit = new uint8_t[switches];
+    scanEnabled = true;
+
+    for( switch_t sw = 0; sw < switches; sw++) {
+        if( switchPins[sw] < SWITCH_SCAN_PIN_FIRST || switchPins[sw] > SWITCH_SCAN_PIN_LAST) {
+            LOGV("InputImpl::InputImpl: Switch pin %d not on port A. Scanner disabled.\n", switchPins[sw]);
+            scanEnabled = false;
+            break;
+        }
+
+        switchBit[sw] = _BV(switchPins[sw] - SWITCH_SCAN_PIN_FIRST);
+
+        if( conf[sw] == SW_CONF_3STATE) {
+            pullupMask |= switchBit[sw];
+        }
+    }
+
+    /* All counters at start value */
+    floatCnt0 = floatCnt1 = pullupCnt0 = pullupCnt1 = 0xff;
+#endif
+
     init();
 }
 
@@ -120,38 +213,127 @@ void InputImpl::init() {
         for( uint8_t i=0; i<switches; i++) {
           portsImpl->portInit( switchPins[i], INPUT);
         }
+
+#ifdef ENABLE_SWITCH_SCANNER
+        /* Initial state without debouncing */
+        if( scanEnabled) {
+            floatState = PINA;
+            PORTA |= pullupMask;
+            delayMicroseconds( 10);
+            pullupState = PINA;
+            PORTA &= ~pullupMask;
+            scanPhase = 0;
+        }
+#endif
     }
 }
 
+#ifdef ENABLE_ADC_OVERSAMPLING
+
+/* Called with every PPM frame.
+ * Conversions are free running. Start them on the first call.
+ */
 void InputImpl::start() {
 
     ATOMIC_BLOCK( ATOMIC_RESTORESTATE) {
-      
+
+        if( !(ADCSRA & _BV(ADATE))) {
+            /* Free running mode: ADTS = 0 in ADCSRB */
+            selectChannel( nextMux);
+            ADCSRA |= _BV(ADEN) | _BV(ADATE) | _BV(ADIE) | _BV(ADSC);
+        }
+    }
+}
+
+/* Conversions are free running and published continuously. */
+bool InputImpl::isAcquired() const {
+
+    return true;
+}
+
+/* Called from the ADC interrupt after a complete oversampling block.
+ * Average, store and swap buffers.
+ */
+void InputImpl::publish() {
+
+    channelValue_t *swap;
+
+    for( uint8_t ch = 0; ch < adcInputs; ch++) {
+        adcValues[ch] = adcInvert( ch, (adcSum[ch] + (ADC_OVERSAMPLING / 2)) >> ADC_OVERSAMPLING_SHIFT);
+        adcSum[ch] = 0;
+    }
+
+    swap = adcSnapshot;
+    adcSnapshot = adcValues;
+    adcValues = swap;
+
+#ifdef ENABLE_LATENCY_STATISTICS
+    adcSnapshotTime_usec = micros();
+#endif
+}
+
+#else
+
+void InputImpl::start() {
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE) {
+
+#ifndef ENABLE_JIT_SCHEDULING
+       /* Publish the last sequence only if it is complete.
+        * Otherwise keep the previous snapshot and restart.
+        */
+       if( mux >= adcInputs) {
+           swapSnapshot();
+       }
+#endif
+
        mux = 0;
        setMux();
 
     }
 }
 
-void InputImpl::setMux() {
+/* True if the sequence started by start() is complete. */
+bool InputImpl::isAcquired() const {
+
+    return mux >= adcInputs;
+}
 
-    uint8_t adc;
+/* Called with interrupts disabled */
+void InputImpl::swapSnapshot() {
+
+    channelValue_t *swap;
+
+    swap = adcSnapshot;
+    adcSnapshot = adcValues;
+    adcValues = swap;
+#ifdef ENABLE_LATENCY_STATISTICS
+    adcSnapshotTime_usec = adcValuesTime_usec;
+#endif
+}
+
+#endif
+
+void InputImpl::setMux() {
 
     if( mux < adcInputs) {
+        selectChannel( mux);
+        ADCSRA |= _BV(ADEN) | _BV(ADSC) | _BV(ADIE);
+    }
+}
+
+void InputImpl::selectChannel( uint8_t ch) {
 
-        adc = analogPins[mux];
+    uint8_t adc = analogPins[ch];
 
-        ADMUX &= ~(_BV(MUX4) | _BV(MUX3) | _BV(MUX2) | _BV(MUX1) | _BV(MUX0));
+    ADMUX &= ~(_BV(MUX4) | _BV(MUX3) | _BV(MUX2) | _BV(MUX1) | _BV(MUX0));
         
-        if( adc < A8) {
-          ADMUX |= (adc - A0);
-          ADCSRB &= ~_BV(MUX5);
-        } else {
-          ADMUX |= (adc - A8);
-          ADCSRB |= _BV(MUX5);
-        }
-          
-        ADCSRA |= _BV(ADEN) | _BV(ADSC) | _BV(ADIE);
+    if( adc < A8) {
+      ADMUX |= (adc - A0);
+      ADCSRB &= ~_BV(MUX5);
+    } else {
+      ADMUX |= (adc - A8);
+      ADCSRB |= _BV(MUX5);
     }
 }
 
@@ -199,7 +381,7 @@ channelValue_t InputImpl::GetAnalogValue( channel_t ch) {
 
     if( ch < adcInputs) {
       ATOMIC_BLOCK( ATOMIC_RESTORESTATE) {
-          v = adcValues[ch];
+          v = adcSnapshot[ch];
       }
       return v;
     }
@@ -209,6 +391,111 @@ channelValue_t InputImpl::GetAnalogValue( channel_t ch) {
     return 0;
 }
 
+void InputImpl::GetAnalogValues( channelValue_t values[]) {
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE) {
+        memcpy( values, adcSnapshot, adcInputs * sizeof(channelValue_t));
+#ifdef ENABLE_LATENCY_STATISTICS
+        readTime_usec = adcSnapshotTime_usec;
+#endif
+    }
+}
+
+#ifdef ENABLE_SWITCH_SCANNER
+
+/* Debounce 8 bits with a 2 bit vertical counter per bit.
+ * A bit of state toggles after the sample differed 4 times in a row.
+ */
+#define DEBOUNCE( sample, state, cnt0, cnt1)    \
+    do {                                        \
+        uint8_t delta = (sample) ^ (state);     \
+        cnt0 = ~(cnt0 & delta);                 \
+        cnt1 = cnt0 ^ (cnt1 & delta);           \
+        delta &= cnt0 & cnt1;                   \
+        state ^= delta;                         \
+    } while( 0 )
+
+/* Read the port in the current pull-up phase and switch the
+ * pull-ups for the next tick. The time between two ticks is the settling time.
+ */
+void InputImpl::scanSwitches() {
+
+    uint8_t sample;
+
+    if( !scanEnabled) {
+        return;
+    }
+
+    sample = PINA;
+
+    if( scanPhase == 0) {
+        DEBOUNCE( sample, floatState, floatCnt0, floatCnt1);
+        PORTA |= pullupMask;
+    } else {
+        DEBOUNCE( sample, pullupState, pullupCnt0, pullupCnt1);
+        PORTA &= ~pullupMask;
+    }
+
+    scanPhase ^= 1;
+}
+
+switchBits_t InputImpl::GetSwitchStates() {
+
+    uint8_t fs, ps;
+    switchState_t state;
+    switchBits_t states = 0;
+
+    if( !scanEnabled) {
+        for( switch_t sw = 0; sw < switches && sw < SWITCHES; sw++) {
+            states |= (switchBits_t)(GetSwitchValue( sw) & 0x03) << SWITCH_BITS_POS( sw);
+        }
+        return states;
+    }
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE) {
+        fs = floatState;
+        ps = pullupState;
+    }
+
+    for( switch_t sw = 0; sw < switches && sw < SWITCHES; sw++) {
+
+        switch( switchConf[sw]) {
+
+        case SW_CONF_2STATE:
+            state = (fs & switchBit[sw]) ? SW_STATE_0 : SW_STATE_1;
+            break;
+
+        case SW_CONF_3STATE:
+            if( !((fs | ps) & switchBit[sw])) state = SW_STATE_2;
+            else if( fs & ps & switchBit[sw]) state = SW_STATE_0;
+            else state = SW_STATE_1;
+            break;
+
+        default:
+            state = SW_STATE_DONTCARE;
+        }
+
+        states |= (switchBits_t)(state & 0x03) << SWITCH_BITS_POS( sw);
+    }
+
+    return states;
+}
+
+#else
+
+switchBits_t InputImpl::GetSwitchStates() {
+
+    switchBits_t states = 0;
+
+    for( switch_t sw = 0; sw < switches && sw < SWITCHES; sw++) {
+        states |= (switchBits_t)(GetSwitchValue( sw) & 0x03) << SWITCH_BITS_POS( sw);
+    }
+
+    return states;
+}
+
+#endif
+
 switchState_t InputImpl::GetSwitchValue( switch_t sw) {
 
     bool s1, s2;
@@ -33,6 +33,31 @@
 /* 10 bit ADC => 1023 */
 #define ADC_RESOLUTION 1023
 
+/* Free running ADC with oversampling.
+ * ADC_OVERSAMPLING_SHIFT selects 2^n samples per channel and published value.
+ */
+#ifdef ENABLE_ADC_OVERSAMPLING
+#ifndef ADC_OVERSAMPLING_SHIFT
+#define ADC_OVERSAMPLING_SHIFT 3
+#endif
+#define ADC_OVERSAMPLING       (1 << ADC_OVERSAMPLING_SHIFT)
+
+/* adcSum is 16 bit */
+#if ADC_OVERSAMPLING_SHIFT > 6
+#error "ADC_OVERSAMPLING_SHIFT must not exceed 6"
+#endif
+#endif
+
+/* Debounced switch scanner.
+ * All switch pins must be on port A (pin 22 - 29).
+ * The port is sampled with and without pull-ups in turns from the
+ * PPM timer interrupt. A state change is accepted after 4 equal samples.
+ */
+#ifdef ENABLE_SWITCH_SCANNER
+#define SWITCH_SCAN_PIN_FIRST  22
+#define SWITCH_SCAN_PIN_LAST   29
+#endif
+
 /* Invert raw channel values */
 #define INVERT_CH1
 #define INVERT_CH2
@@ -54,12 +79,68 @@ class InputImpl
         const uint8_t *analogPins;
         const uint8_t *switchPins;
 
+        /* Double buffer for ADC values.
+         * adcValues is filled by the ADC interrupt, adcSnapshot holds the
+         * last complete conversion sequence. Both are swapped by start()
+         * or, with ENABLE_JIT_SCHEDULING, as soon as the sequence is complete.
+         */
         channelValue_t *adcValues = NULL;
+        channelValue_t *adcSnapshot = NULL;
+
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* micros() of the last conversion of adcValues and adcSnapshot
+         * and of the snapshot returned by GetAnalogValues().
+         */
+        unsigned long adcValuesTime_usec = 0;
+        unsigned long adcSnapshotTime_usec = 0;
+        unsigned long readTime_usec = 0;
+#endif
 
         channel_t adcInputs;  /* Total number of ADC inputs */
         switch_t switches;
 
-        uint8_t mux;
+        /* Shared with the ADC interrupt */
+        volatile uint8_t mux;
+
+#ifdef ENABLE_ADC_OVERSAMPLING
+        /* Sum of the samples of the current oversampling block */
+        uint16_t *adcSum = NULL;
+
+        /* In free running mode the next conversion is already started
+         * when the interrupt fires. mux is the channel of the conversion
+         * in progress, nextMux the channel selected for the following one.
+         */
+        volatile uint8_t nextMux;
+        volatile uint8_t pass;
+
+        void publish();
+#else
+        void swapSnapshot();
+#endif
+
+#ifdef ENABLE_SWITCH_SCANNER
+        /* Port A bit of each switch */
+        uint8_t *switchBit = NULL;
+
+        /* Bits of 3 state switches. Pull-ups are switched on these. */
+        uint8_t pullupMask = 0;
+
+        /* Scanner disabled if a switch is not on port A */
+        bool scanEnabled = false;
+
+        /* 0: Pull-ups are off, 1: Pull-ups are on */
+        uint8_t scanPhase = 0;
+
+        /* Debounced port state without and with pull-ups and 
+         * the vertical counters of both.
+         */
+        uint8_t floatState, pullupState;
+        uint8_t floatCnt0, floatCnt1;
+        uint8_t pullupCnt0, pullupCnt1;
+
+        /* Called from the PPM timer interrupt */
+        void scanSwitches();
+#endif
 
         InputImpl( channel_t stickCnt, channel_t trimCnt, channel_t auxCnt, const uint8_t analogPins[],
                    switch_t switches, const switchConf_t *conf, const uint8_t switchPins[]);
@@ -67,13 +148,24 @@ class InputImpl
         void init();
 
         void start();
+        bool isAcquired() const;
         void setMux();
+        void selectChannel( uint8_t ch);
 
         switch_t GetSwitches();
 
         channelValue_t GetStickValue( channel_t ch);
         channelValue_t GetTrimValue( channel_t ch);
         channelValue_t GetAuxValue( channel_t ch);
+
+        /* Copy all analog values (sticks, trims and aux inputs) at once. */
+        void GetAnalogValues( channelValue_t values[]);
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* Time of the snapshot returned by the last GetAnalogValues() */
+        unsigned long GetAnalogTime() const { return readTime_usec; }
+#endif
+        /* States of all switches. 2 bits per switch, see SWITCH_BITS_POS() */
+        switchBits_t GetSwitchStates();
         switchState_t GetSwitchValue( switch_t sw);
         switchConf_t GetSwitchConf( switch_t sw);
 };
@@ -39,10 +39,15 @@ static channel_t outputChannel = 0;
  */
 static volatile timingUsec_t inFrameTime_half_uSec = 0;
 static volatile timingUsec_t maxFrameTime_half_uSec = 0;
+static volatile timingUsec_t minFrameTime_half_uSec = 0;
 
 ISR(TIMER3_OVF_vect) {
 
   timingUsec_t nextTimerTop;
+
+#ifdef ENABLE_SWITCH_SCANNER
+  inputImpl->scanSwitches();
+#endif
   
   /* Output compare register is set to trigger at space end which is 400 usec. 
    * The pin will be set to high at output compare match and 
@@ -51,15 +56,25 @@ ISR(TIMER3_OVF_vect) {
   if( outputChannel >= PPM_CHANNELS) {
 
     outputImpl->switchSet();
+#ifndef ENABLE_JIT_SCHEDULING
     inputImpl->start();
+#endif
 
+#ifdef ENABLE_ADAPTIVE_PPM
+    /* End the frame after the sync gap */
+    nextTimerTop = PPM_SYNC_usec << 1;
+#else
     /* Fill gap until end of frame time (22msec) */
     nextTimerTop = (PPM_FRAME_usec << 1) - inFrameTime_half_uSec;
+#endif
     inFrameTime_half_uSec += nextTimerTop;
 
     if( inFrameTime_half_uSec > maxFrameTime_half_uSec) {
         maxFrameTime_half_uSec = inFrameTime_half_uSec;
     }
+    if( minFrameTime_half_uSec == 0 || inFrameTime_half_uSec < minFrameTime_half_uSec) {
+        minFrameTime_half_uSec = inFrameTime_half_uSec;
+    }
 
     inFrameTime_half_uSec = 0;
     outputChannel = 0;
@@ -99,8 +114,17 @@ void OutputImpl::init() {
         }
 
         maxFrameTime_half_uSec = 0;
+        minFrameTime_half_uSec = 0;
         ppmOverrun = 0;
         channelSetDone = true;
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* No set has a snapshot time yet */
+        inputTime_usec[0] = inputTime_usec[1] = micros();
+        latencyValid = false;
+#endif
+#ifdef ENABLE_JIT_SCHEDULING
+        nextSwitch_usec = micros();
+#endif
 
         outputChannel = 0;
         inFrameTime_half_uSec = 0;
@@ -151,6 +175,17 @@ timingUsec_t OutputImpl::getMaxFrameTime() {
     return t;
 }
 
+timingUsec_t OutputImpl::getMinFrameTime() {
+    
+    timingUsec_t t;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE) {
+        t = minFrameTime_half_uSec / 2;
+    }
+    
+    return t;
+}
+
 
 /* An overrun occurs if not all channels in the modifiable set
  * were set and a switch occurs.
@@ -160,19 +195,93 @@ uint16_t OutputImpl::getOverrunCounter() {
     return ppmOverrun;
 }
 
+#ifdef ENABLE_JIT_SCHEDULING
+/* Sum of all channel pulses of a set */
+static inline timingUsec_t pulseTime( const ppmSet_t &set) {
+
+    timingUsec_t t = 0;
+
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        t += set.channel[ch];
+    }
+
+    return t;
+}
+#endif
+
 /* Switch active and modifiable set.
  * Increate the ppmOverrun counter if the channelSetDone flag has not 
  * been set.
  */
 void OutputImpl::switchSet() {
     
+#if defined( ENABLE_JIT_SCHEDULING ) && !defined( ENABLE_ADAPTIVE_PPM )
+    /* The set just sent. The gap fills its frame up to PPM_FRAME_usec. */
+    timingUsec_t sent_usec = pulseTime( ppmSet[currentSet]);
+#endif
+
     if( channelSetDone) {
         channelSetDone = false; 
         currentSet = OTHER_PPMSET( currentSet);
+#ifdef ENABLE_LATENCY_STATISTICS
+        latency_usec = micros() - inputTime_usec[currentSet];
+        latencyValid = true;
+#endif
 
     } else {
         ppmOverrun++;
     }
+
+#ifdef ENABLE_JIT_SCHEDULING
+#ifdef ENABLE_ADAPTIVE_PPM
+    /* Sync gap followed by all channels of the current set */
+    timingUsec_t frame_usec = PPM_SYNC_usec + pulseTime( ppmSet[currentSet]);
+#else
+    /* Rest of the frame followed by all channels of the current set */
+    timingUsec_t frame_usec = PPM_FRAME_usec - sent_usec + pulseTime( ppmSet[currentSet]);
+#endif
+    nextSwitch_usec = micros() + frame_usec;
+#endif
+}
+
+#ifdef ENABLE_JIT_SCHEDULING
+unsigned long OutputImpl::getNextSwitchTime() {
+
+    unsigned long t;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE) {
+        t = nextSwitch_usec;
+    }
+
+    return t;
+}
+#endif
+
+#ifdef ENABLE_LATENCY_STATISTICS
+void OutputImpl::SetInputTime( unsigned long t) {
+
+    if( !channelSetDone) {
+        inputTime_usec[ OTHER_PPMSET( currentSet) ] = t;
+    }
+}
+
+bool OutputImpl::getLatency( uint32_t &usec) {
+
+    bool valid;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE) {
+        valid = latencyValid;
+        usec = latency_usec;
+        latencyValid = false;
+    }
+
+    return valid;
+}
+#endif
+
+bool OutputImpl::isChannelSetDone() const {
+
+    return channelSetDone;
 }
 
 bool OutputImpl::acceptChannels() {
@@ -180,51 +289,55 @@ bool OutputImpl::acceptChannels() {
     return !channelSetDone;
 }
 
-/* Set timing for a channel.
- * The value must be between -PPM_RANGE_usec and PPM_RANGE_usec.
- * A value outside is clipped.
- * 
- * Setting the last channel will set the channelSetDone flag.
+/* Convert a channel value to the pulse length.
+ * A value outside of +/-PPM_RANGEMAX_usec is clipped.
+ *
+ * value
+ * =======
+ * CHANNELVALUE_MID   0
+ * CHANNELVALUE_MIN   -1250 == -125%  == -500
+ * CHANNELVALUE_MAX    1250 ==  125%  ==  500
+ *
+ * To:
  * 
- * SO SET THE LAST CHANNEL LAST !!
+ * ppmTiming_t
+ * ===========
+ * PPM_MID_usec        ((timingUsec_t) 1500)
+ * PPM_MIN_usec        (PPM_MID_usec - PPM_RANGE_usec) = 900
+ * PPM_MAX_usec        (PPM_MID_usec + PPM_RANGE_usec) = 2100
+ */
+static inline timingUsec_t toPulse( channelValue_t value) {
+
+    timingUsec_t t = PPM_MID_usec + (value * 2 / 5);
+
+    if( t < PPM_MIN_usec) t = PPM_MIN_usec;
+    if( t > PPM_MAX_usec) t = PPM_MAX_usec;
+
+    return t;
+}
+
+/* Set the timing of all channels and mark the set as done.
  * 
+ * The interrupt routine does not touch the modifiable set as long as
+ * channelSetDone is false. So the set is filled with interrupts enabled.
+ * Only setting channelSetDone is done atomically. This also makes sure
+ * all values are written before the interrupt routine can switch sets.
+ *
+ * Does nothing if the last set has not been switched to yet.
  */
-void OutputImpl::SetChannelValue(int channel, int value) {
+void OutputImpl::SetChannelValues( const channelValue_t values[]) {
 
-    timingUsec_t t;
+    if( channelSetDone) {
+        return;
+    }
 
-    /* Convert:
-     * 
-     * value
-     * =======
-     * CHANNELVALUE_MID   0
-     * CHANNELVALUE_MIN   -1250 == -125%  == -500
-     * CHANNELVALUE_MAX    1250 ==  125%  ==  500
-     *
-     * To:
-     * 
-     * ppmTiming_t
-     * ===========
-     * PPM_MID_usec        ((timingUsec_t) 1500)
-     * PPM_MIN_usec        (PPM_MID_usec - PPM_RANGE_usec) = 900
-     * PPM_MAX_usec        (PPM_MID_usec + PPM_RANGE_usec) = 2100
-     *  
-     */
-
-    if( channel < PPM_CHANNELS) {
-
-        t = PPM_MID_usec + (value * 2 / 5);
-
-        if( t < PPM_MIN_usec) t = PPM_MIN_usec;
-        if( t > PPM_MAX_usec) t = PPM_MAX_usec;
-        
-        ATOMIC_BLOCK( ATOMIC_RESTORESTATE) {
+    timingUsec_t *channel = ppmSet[ OTHER_PPMSET( currentSet) ].channel;
 
-            ppmSet[ OTHER_PPMSET( currentSet) ].channel[ channel ] = t;
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        channel[ch] = toPulse( values[ch]);
+    }
 
-            if( channel == PPM_CHANNELS-1) {
-                channelSetDone = true;
-            }
-        }
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE) {
+        channelSetDone = true;
     }
 }
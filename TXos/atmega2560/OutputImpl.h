@@ -54,6 +54,9 @@
 
 
 #define PPM_FRAME_usec      ((timingUsec_t) PPM_FRAME_TIME_usec)
+#ifdef ENABLE_ADAPTIVE_PPM
+#define PPM_SYNC_usec       ((timingUsec_t) PPM_SYNC_GAP_usec)
+#endif
 #define PPM_SPACE_usec      ((timingUsec_t)  400)
 #define PPM_MID_usec        ((timingUsec_t) 1500)
 
@@ -88,18 +91,49 @@ class OutputImpl
          * This should always be 0.
          */
         uint16_t ppmOverrun;
-        bool channelSetDone;
+        volatile bool channelSetDone;
+
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* ADC snapshot time of both sets */
+        unsigned long inputTime_usec[2];
+        /* Age of the input of the set switched to last */
+        volatile uint32_t latency_usec;
+        volatile bool latencyValid;
+#endif
+
+#ifdef ENABLE_JIT_SCHEDULING
+        /* Expected micros() of the next switchSet() */
+        volatile unsigned long nextSwitch_usec;
+#endif
     	
     public:
         OutputImpl();
 
         void switchSet();
 
+        /* True if the modifiable set is complete and waits for
+         * the switch at the next frame start.
+         */
+        bool isChannelSetDone() const;
         bool acceptChannels();
-        void SetChannelValue( int channel, int value);
+        void SetChannelValues( const channelValue_t values[]);
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* Set the ADC snapshot time of the next set.
+         * Must be called before SetChannelValues().
+         */
+        void SetInputTime( unsigned long t);
+        /* Returns true and the latency if a new set was switched to
+         * since the last call.
+         */
+        bool getLatency( uint32_t &usec);
+#endif
+#ifdef ENABLE_JIT_SCHEDULING
+        unsigned long getNextSwitchTime();
+#endif
         
         timingUsec_t getInFrameTime();
         timingUsec_t getMaxFrameTime();
+        timingUsec_t getMinFrameTime();
         uint16_t getOverrunCounter();
         
     private:
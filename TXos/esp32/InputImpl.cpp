@@ -27,9 +27,20 @@
 #include "InputImpl.h"
 #include "PortsImpl.h"
 
+#ifdef ENABLE_ADC_OVERSAMPLING
+#include "driver/adc.h"
+#endif
+
 extern InputImpl *inputImpl;
 extern PortsImpl *portsImpl;
 
+#ifdef ENABLE_ADC_OVERSAMPLING
+
+/* Receives the DMA results in GetAnalogValues() */
+static uint8_t adcFrame[ADC_DMA_FRAME_BYTES];
+
+#endif
+
 InputImpl::InputImpl( channel_t stickCnt, channel_t trimCnt, channel_t auxCnt,
                       const uint8_t analogPins[],
                       switch_t switches, const switchConf_t *conf,
@@ -50,6 +61,28 @@ InputImpl::InputImpl( channel_t stickCnt, channel_t trimCnt, channel_t auxCnt,
         adcValues[i] = 0;
     }
 
+#ifdef ENABLE_ADC_OVERSAMPLING
+    adc2Channel = new channel_t[adcInputs];
+
+    for( uint8_t a = 0; a < ADC1_CHANNELS; a++) {
+        adc1Channel[a] = ADC1_CHANNEL_NONE;
+        adc1Sum[a] = 0;
+        adc1Samples[a] = 0;
+    }
+
+    for( channel_t ch = 0; ch < adcInputs; ch++) {
+        if( IS_ADC1_PIN( analogPins[ch])) {
+            /* GPIO 36 is ADC1 channel 0, GPIO 32 is channel 4 ... */
+            uint8_t a = digitalPinToAnalogChannel( analogPins[ch]);
+            adc1Channel[a] = ch;
+            adc1ChannelMask |= (1 << a);
+            adc1Count++;
+        } else {
+            adc2Channel[adc2Count++] = ch;
+        }
+    }
+#endif
+
     init();
 }
 
@@ -61,8 +94,106 @@ void InputImpl::init() {
     for( uint8_t i=0; i<switches; i++) {
         portsImpl->portInit( switchPins[i], INPUT);
     }
+
+#ifdef ENABLE_ADC_OVERSAMPLING
+    if( adc1Count > 0) {
+        startContinuous();
+    }
+
+    /* Initial values for the inputs on ADC2 */
+    for( channel_t i = 0; i < adc2Count; i++) {
+        adcValues[adc2Channel[i]] = analogRead( analogPins[adc2Channel[i]]);
+    }
+#endif
+}
+
+#ifdef ENABLE_ADC_OVERSAMPLING
+
+/* Let the ADC DMA driver convert all ADC1 inputs in a loop. */
+void InputImpl::startContinuous() {
+
+    adc_digi_init_config_t initConfig = {};
+    adc_digi_configuration_t config = {};
+    adc_digi_pattern_config_t pattern[ADC1_CHANNELS] = {};
+    uint8_t patternCount = 0;
+
+    initConfig.max_store_buf_size = ADC_DMA_BUFFER_BYTES;
+    initConfig.conv_num_each_intr = ADC_DMA_FRAME_BYTES;
+    initConfig.adc1_chan_mask = adc1ChannelMask;
+    initConfig.adc2_chan_mask = 0;
+
+    for( uint8_t a = 0; a < ADC1_CHANNELS; a++) {
+        if( adc1Channel[a] != ADC1_CHANNEL_NONE) {
+            pattern[patternCount].atten = ADC_ATTEN_DB_11;
+            pattern[patternCount].channel = a;
+            pattern[patternCount].unit = 0; /* ADC1 */
+            pattern[patternCount].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+            patternCount++;
+        }
+    }
+
+    config.conv_limit_en = 1;   /* Required on ESP32 */
+    config.conv_limit_num = 250;
+    config.pattern_num = patternCount;
+    config.adc_pattern = pattern;
+    config.sample_freq_hz = ADC_CONTINUOUS_FREQ_HZ;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+
+    if( adc_digi_initialize( &initConfig) != ESP_OK
+        || adc_digi_controller_configure( &config) != ESP_OK
+        || adc_digi_start() != ESP_OK) {
+
+        LOG("** InputImpl::init: Failed to set up continuous ADC\n");
+    }
+}
+
+/* Read all conversions buffered by the driver.
+ * Each ADC1 input is updated with the average of every
+ * ADC_OVERSAMPLING conversions. The last average wins.
+ * Returns true if at least one input was updated.
+ */
+bool InputImpl::readContinuous() {
+
+    uint32_t length;
+    esp_err_t ret;
+    bool updated = false;
+
+    for( ;;) {
+        length = 0;
+        ret = adc_digi_read_bytes( adcFrame, ADC_DMA_FRAME_BYTES, &length, 0);
+
+        /* ESP_ERR_INVALID_STATE: Driver buffer overflow. The data is still valid. */
+        if( (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) || length == 0) {
+            break;
+        }
+
+        for( uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+            const adc_digi_output_data_t *p = (const adc_digi_output_data_t*)&adcFrame[i];
+            uint8_t a = p->type1.channel;
+
+            if( a >= ADC1_CHANNELS || adc1Channel[a] == ADC1_CHANNEL_NONE) {
+                continue;
+            }
+
+            adc1Sum[a] += p->type1.data;
+
+            if( ++adc1Samples[a] >= ADC_OVERSAMPLING) {
+                /* 12 bit conversions, 10 bit like analogRead() */
+                adcValues[adc1Channel[a]] = (channelValue_t)
+                    ((adc1Sum[a] + (ADC_OVERSAMPLING * 2)) >> (ADC_OVERSAMPLING_SHIFT + 2));
+                adc1Sum[a] = 0;
+                adc1Samples[a] = 0;
+                updated = true;
+            }
+        }
+    }
+
+    return updated;
 }
 
+#endif
+
 void InputImpl::start() {
 
 }
@@ -105,6 +236,44 @@ channelValue_t InputImpl::GetAuxValue( channel_t ch) {
   return 0;
 }
 
+#ifdef ENABLE_ADC_OVERSAMPLING
+
+channelValue_t InputImpl::GetAnalogValue( channel_t ch) {
+
+    if( ch < adcInputs) {
+        return adcValues[ch];
+    }
+
+    LOGV("InputImpl::GetStickValue: Illegal channel no. %d", ch);
+
+    return 0;
+}
+
+/* Take the latest averaged ADC1 values if new conversions are
+ * complete, otherwise keep the previous values.
+ * Read one ADC2 input per call.
+ */
+void InputImpl::GetAnalogValues( channelValue_t values[]) {
+
+    if( adc1Count > 0 && readContinuous()) {
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* The driver does not time stamp conversions. Use the read time. */
+        readTime_usec = micros();
+#endif
+    }
+
+    if( adc2Count > 0) {
+        adcValues[adc2Channel[adc2Next]] = analogRead( analogPins[adc2Channel[adc2Next]]);
+        if( ++adc2Next >= adc2Count) {
+            adc2Next = 0;
+        }
+    }
+
+    memcpy( values, adcValues, adcInputs * sizeof(channelValue_t));
+}
+
+#else
+
 channelValue_t InputImpl::GetAnalogValue( channel_t ch) {
 
     channelValue_t v;
@@ -120,6 +289,19 @@ channelValue_t InputImpl::GetAnalogValue( channel_t ch) {
     return 0;
 }
 
+void InputImpl::GetAnalogValues( channelValue_t values[]) {
+
+#ifdef ENABLE_LATENCY_STATISTICS
+    readTime_usec = micros();
+#endif
+
+    for( channel_t ch = 0; ch < adcInputs; ch++) {
+        values[ch] = analogRead( analogPins[ch]);
+    }
+}
+
+#endif
+
 switchState_t InputImpl::GetSwitchValue( switch_t sw) {
 
     bool s1, s2;
@@ -163,3 +345,14 @@ switchConf_t InputImpl::GetSwitchConf( switch_t sw) {
   
   return switchConf[sw];
 }
+
+switchBits_t InputImpl::GetSwitchStates() {
+
+    switchBits_t states = 0;
+
+    for( switch_t sw = 0; sw < switches && sw < SWITCHES; sw++) {
+        states |= (switchBits_t)(GetSwitchValue( sw) & 0x03) << SWITCH_BITS_POS( sw);
+    }
+
+    return states;
+}
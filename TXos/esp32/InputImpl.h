@@ -30,6 +30,35 @@
 #include "TXos.h"
 #include "Controls.h"
 
+/* Continuous ADC with oversampling.
+ * Inputs on ADC1 (GPIO 32 - 39) are sampled in the background by the
+ * ADC DMA driver of ESP-IDF 4.4 (adc_digi_*, arduino-esp32 2.x).
+ * ADC_OVERSAMPLING conversions per input are averaged.
+ * Inputs on ADC2 are not supported in continuous mode. They are
+ * read with analogRead(), one input per call of GetAnalogValues().
+ */
+#ifdef ENABLE_ADC_OVERSAMPLING
+#ifndef ADC_OVERSAMPLING_SHIFT
+#define ADC_OVERSAMPLING_SHIFT 3
+#endif
+#define ADC_OVERSAMPLING       (1 << ADC_OVERSAMPLING_SHIFT)
+
+/* Total conversion rate of ADC1. 20KHz is the minimum. */
+#define ADC_CONTINUOUS_FREQ_HZ 20000
+
+/* ADC1 has 8 channels */
+#define ADC1_CHANNELS          8
+#define ADC1_CHANNEL_NONE      0xff
+
+/* Bytes per DMA transfer and size of the driver buffer.
+ * At 20KHz the buffer holds about 50 msec of conversions.
+ */
+#define ADC_DMA_FRAME_BYTES    256
+#define ADC_DMA_BUFFER_BYTES   2048
+
+#define IS_ADC1_PIN( p)        ((p) >= 32 && (p) <= 39)
+#endif
+
 class InputImpl
 {
     private:
@@ -47,21 +76,55 @@ class InputImpl
 
         channelValue_t *adcValues = NULL;
 
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* micros() of the values returned by the last GetAnalogValues() */
+        unsigned long readTime_usec = 0;
+#endif
+
         channel_t adcInputs;  /* Total number of ADC inputs */
         switch_t switches;
 
+#ifdef ENABLE_ADC_OVERSAMPLING
+        /* Input channel of each ADC1 channel or ADC1_CHANNEL_NONE */
+        channel_t adc1Channel[ADC1_CHANNELS];
+        uint16_t adc1ChannelMask = 0;
+        channel_t adc1Count = 0;
+
+        /* Sum and number of conversions per ADC1 channel */
+        uint32_t adc1Sum[ADC1_CHANNELS];
+        uint8_t adc1Samples[ADC1_CHANNELS];
+
+        void startContinuous();
+        bool readContinuous();
+
+        /* Channels on ADC2, read one at a time */
+        channel_t *adc2Channel = NULL;
+        channel_t adc2Count = 0;
+        channel_t adc2Next = 0;
+#endif
+
         InputImpl( channel_t stickCnt, channel_t trimCnt, channel_t auxCnt, const uint8_t analogPins[],
                    switch_t switches, const switchConf_t *conf, const uint8_t switchPins[]);
 
         void init();
 
         void start();
+        /* Conversions are synchronous or continuous. Always complete. */
+        bool isAcquired() const { return true; }
 
         switch_t GetSwitches();
 
         channelValue_t GetStickValue( channel_t ch);
         channelValue_t GetTrimValue( channel_t ch);
         channelValue_t GetAuxValue( channel_t ch);
+
+        /* Copy all analog values (sticks, trims and aux inputs) at once. */
+        void GetAnalogValues( channelValue_t values[]);
+#ifdef ENABLE_LATENCY_STATISTICS
+        unsigned long GetAnalogTime() const { return readTime_usec; }
+#endif
+        /* States of all switches. 2 bits per switch, see SWITCH_BITS_POS() */
+        switchBits_t GetSwitchStates();
         switchState_t GetSwitchValue( switch_t sw);
         switchConf_t GetSwitchConf( switch_t sw);
 };
@@ -27,9 +27,145 @@
 #include "OutputImpl.h"
 #include "InputImpl.h"
 
+#ifdef ENABLE_RMT_PPM
+#include <esp_timer.h>
+#endif
+
 extern OutputImpl* outputImpl;
 extern InputImpl* inputImpl;
 
+static timingUsec_t maxFrameTime_uSec;
+static timingUsec_t minFrameTime_uSec;
+
+/* Called with ppmMux held */
+static inline void IRAM_ATTR updateFrameTime( timingUsec_t frameTime_uSec) {
+
+    if( frameTime_uSec > maxFrameTime_uSec) {
+        maxFrameTime_uSec = frameTime_uSec;
+    }
+    if( minFrameTime_uSec == 0 || frameTime_uSec < minFrameTime_uSec) {
+        minFrameTime_uSec = frameTime_uSec;
+    }
+}
+
+portMUX_TYPE ppmMux = portMUX_INITIALIZER_UNLOCKED;
+
+#ifdef ENABLE_RMT_PPM
+
+/* Start of the last frame. Used to measure the achieved frame time. */
+static int64_t lastFrameStart_uSec;
+
+/* Called by the RMT driver at the end of a frame.
+ * The pin idles high which is the level of the sync gap. So the
+ * time until the next frame starts only extends the sync gap.
+ * All channel edges are timed by the RMT peripheral.
+ */
+static void IRAM_ATTR ppmFrameDone( rmt_channel_t channel, void *arg) {
+
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL_ISR(&ppmMux);
+    outputImpl->switchSet();
+    outputImpl->encodeFrame();
+
+    if( lastFrameStart_uSec != 0) {
+        updateFrameTime( (timingUsec_t)(now - lastFrameStart_uSec));
+    }
+    lastFrameStart_uSec = now;
+    portEXIT_CRITICAL_ISR(&ppmMux);
+
+    rmt_fill_tx_items( PPM_RMT_CHANNEL, outputImpl->rmtItems, PPM_RMT_ITEMS, 0);
+    rmt_tx_start( PPM_RMT_CHANNEL, true);
+}
+
+OutputImpl::OutputImpl() {
+
+    init();
+}
+
+/* Initialization:
+ * - Set all channels to mid.
+ * - Configure RMT channel with 1 usec resolution and idle level high.
+ * - Send the first frame. All further frames are started from ppmFrameDone().
+ */
+void OutputImpl::init() {
+
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX( (gpio_num_t)PPM_PORT, PPM_RMT_CHANNEL);
+
+    for (channel_t i = 0; i < PPM_CHANNELS; i++) {
+        ppmSet[0].channel[i] = PPM_MID_usec;
+        ppmSet[1].channel[i] = PPM_MID_usec;
+    }
+
+    currentSet = 0;
+    ppmOverrun = 0;
+    channelSetDone = true;
+#ifdef ENABLE_LATENCY_STATISTICS
+    /* No set has a snapshot time yet */
+    inputTime_usec[0] = inputTime_usec[1] = micros();
+    latencyValid = false;
+#endif
+#ifdef ENABLE_JIT_SCHEDULING
+    nextSwitch_usec = micros();
+#endif
+
+    maxFrameTime_uSec = 0;
+    minFrameTime_uSec = 0;
+    lastFrameStart_uSec = 0;
+
+    /* 80 MHz APB clock / 80 = 1 usec */
+    config.clk_div = 80;
+    config.mem_block_num = 1;
+    config.tx_config.loop_en = false;
+    config.tx_config.carrier_en = false;
+    config.tx_config.idle_output_en = true;
+    config.tx_config.idle_level = RMT_IDLE_LEVEL_HIGH;
+
+    rmt_config( &config);
+    rmt_driver_install( PPM_RMT_CHANNEL, 0, 0);
+    rmt_register_tx_end_callback( ppmFrameDone, NULL);
+
+    encodeFrame();
+    rmt_fill_tx_items( PPM_RMT_CHANNEL, rmtItems, PPM_RMT_ITEMS, 0);
+    rmt_tx_start( PPM_RMT_CHANNEL, true);
+}
+
+/* Convert the current set into RMT items.
+ * Each channel is a low space followed by a high mark.
+ * The last item is the space and the sync gap until the end of the frame.
+ * With ENABLE_ADAPTIVE_PPM the frame ends right after the sync gap.
+ */
+void IRAM_ATTR OutputImpl::encodeFrame() {
+
+    const timingUsec_t *channel = ppmSet[currentSet].channel;
+    timingUsec_t inFrameTime_uSec = 0;
+    rmt_item32_t *item = rmtItems;
+
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        item->level0 = 0;
+        item->duration0 = PPM_SPACE_usec;
+        item->level1 = 1;
+        item->duration1 = channel[ch] - PPM_SPACE_usec;
+        inFrameTime_uSec += channel[ch];
+        item++;
+    }
+
+    item->level0 = 0;
+    item->duration0 = PPM_SPACE_usec;
+    item->level1 = 1;
+#ifdef ENABLE_ADAPTIVE_PPM
+    item->duration1 = PPM_SYNC_usec - PPM_SPACE_usec;
+#else
+    item->duration1 = PPM_FRAME_usec - inFrameTime_uSec - PPM_SPACE_usec;
+#endif
+    item++;
+
+    /* End marker */
+    item->val = 0;
+}
+
+#else
+
 /* PPM generation state machine state.
  * Used in the interrupt routine.
  */
@@ -42,7 +178,6 @@ static uint8_t outputState;
 #define END_OF_LAST_SPACE       4
 
 static timingUsec_t lastChStart_uSec;
-static timingUsec_t maxFrameTime_uSec;
 static channel_t outputChannel;
 
 /* 1Mhz results in 1 usec resolution */
@@ -61,8 +196,6 @@ static hw_timer_t *ppmTimer = NULL;
 /* This compensates ISR service time */
 #define ISR_ADJUST   3
 
-portMUX_TYPE ppmMux = portMUX_INITIALIZER_UNLOCKED;
-
 void ARDUINO_ISR_ATTR ppmTimerISR() {
 
     timingUsec_t inFrameTime_uSec;
@@ -99,9 +232,7 @@ void ARDUINO_ISR_ATTR ppmTimerISR() {
         PIN_LOW();
         timerWrite( ppmTimer, RESET_ADJUST);
 
-        if( inFrameTime_uSec > maxFrameTime_uSec) {
-            maxFrameTime_uSec = inFrameTime_uSec;
-        }
+        updateFrameTime( inFrameTime_uSec);
 
         nextTimerValue_uSec = PPM_SPACE_usec;
         lastChStart_uSec = 0;
@@ -110,7 +241,12 @@ void ARDUINO_ISR_ATTR ppmTimerISR() {
 
     case END_OF_LAST_SPACE:
         PIN_HIGH();
+#ifdef ENABLE_ADAPTIVE_PPM
+        /* lastChStart_uSec is the start of the last space */
+        nextTimerValue_uSec = lastChStart_uSec + PPM_SYNC_usec;
+#else
         nextTimerValue_uSec = PPM_FRAME_usec;
+#endif
         outputState = BEGIN_OF_FIRST_SPACE;
         break;
 
@@ -149,9 +285,18 @@ void OutputImpl::init() {
     currentSet = 0;
     ppmOverrun = 0;
     channelSetDone = true;
+#ifdef ENABLE_LATENCY_STATISTICS
+    /* No set has a snapshot time yet */
+    inputTime_usec[0] = inputTime_usec[1] = micros();
+    latencyValid = false;
+#endif
+#ifdef ENABLE_JIT_SCHEDULING
+    nextSwitch_usec = micros();
+#endif
 
     outputChannel = 0;
     maxFrameTime_uSec = 0;
+    minFrameTime_uSec = 0;
     outputState = BEGIN_OF_FIRST_SPACE;
 
     pinMode(PPM_PORT, OUTPUT);
@@ -167,6 +312,8 @@ void OutputImpl::init() {
     }
 }
 
+#endif
+
 timingUsec_t OutputImpl::getMaxFrameTime() {
 
     timingUsec_t t;
@@ -178,6 +325,17 @@ timingUsec_t OutputImpl::getMaxFrameTime() {
     return t;
 }
 
+timingUsec_t OutputImpl::getMinFrameTime() {
+
+    timingUsec_t t;
+
+    portENTER_CRITICAL(&ppmMux);
+    t = minFrameTime_uSec;
+    portEXIT_CRITICAL(&ppmMux);
+
+    return t;
+}
+
 
 /* An overrun occurs if not all channels in the modifiable set
  * were set and a switch occurs.
@@ -193,19 +351,98 @@ uint16_t OutputImpl::getOverrunCounter() {
     return c;
 }
 
+#ifdef ENABLE_JIT_SCHEDULING
+/* Sum of all channel pulses of a set */
+static inline timingUsec_t pulseTime( const ppmSet_t &set) {
+
+    timingUsec_t t = 0;
+
+    for (channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        t += set.channel[ch];
+    }
+
+    return t;
+}
+#endif
+
 /* Switch active and modifiable set.
  * Increase the ppmOverrun counter if the channelSetDone flag has not
  * been set in time.
  */
 void OutputImpl::switchSet() {
 
+#if defined( ENABLE_JIT_SCHEDULING ) && !defined( ENABLE_ADAPTIVE_PPM ) && !defined( ENABLE_RMT_PPM )
+    /* The set just sent. The gap fills its frame up to PPM_FRAME_usec. */
+    timingUsec_t sent_uSec = pulseTime( ppmSet[currentSet]);
+#endif
+
     if (channelSetDone) {
         channelSetDone = false;
         currentSet = OTHER_PPMSET(currentSet);
+#ifdef ENABLE_LATENCY_STATISTICS
+        latency_usec = micros() - inputTime_usec[currentSet];
+        latencyValid = true;
+#endif
     }
     else {
         ppmOverrun++;
     }
+
+#ifdef ENABLE_JIT_SCHEDULING
+#ifdef ENABLE_ADAPTIVE_PPM
+    /* All channels of the current set followed by the sync gap */
+    timingUsec_t frame_uSec = PPM_SYNC_usec + pulseTime( ppmSet[currentSet]);
+#elif defined( ENABLE_RMT_PPM )
+    /* Called at the frame end, the whole frame follows */
+    timingUsec_t frame_uSec = PPM_FRAME_usec;
+#else
+    /* Called after the last pulse. Rest of the frame followed by
+     * all channels of the current set.
+     */
+    timingUsec_t frame_uSec = PPM_FRAME_usec - sent_uSec + pulseTime( ppmSet[currentSet]);
+#endif
+    nextSwitch_usec = micros() + frame_uSec;
+#endif
+}
+
+#ifdef ENABLE_JIT_SCHEDULING
+unsigned long OutputImpl::getNextSwitchTime() {
+
+    unsigned long t;
+
+    portENTER_CRITICAL(&ppmMux);
+    t = nextSwitch_usec;
+    portEXIT_CRITICAL(&ppmMux);
+
+    return t;
+}
+#endif
+
+#ifdef ENABLE_LATENCY_STATISTICS
+void OutputImpl::SetInputTime( unsigned long t) {
+
+    if (!channelSetDone) {
+        inputTime_usec[OTHER_PPMSET(currentSet)] = t;
+    }
+}
+
+bool OutputImpl::getLatency( uint32_t &usec) {
+
+    bool valid;
+
+    portENTER_CRITICAL(&ppmMux);
+    valid = latencyValid;
+    usec = latency_usec;
+    latencyValid = false;
+    portEXIT_CRITICAL(&ppmMux);
+
+    return valid;
+}
+#endif
+
+bool OutputImpl::isChannelSetDone() const {
+
+    return channelSetDone;
 }
 
 bool OutputImpl::acceptChannels() {
@@ -213,50 +450,55 @@ bool OutputImpl::acceptChannels() {
     return !channelSetDone;
 }
 
-/* Set timing for a channel.
- * The value must be between -PPM_RANGE_usec and PPM_RANGE_usec.
- * A value outside is clipped.
+/* Convert a channel value to the pulse length.
+ * A value outside of +/-PPM_RANGEMAX_usec is clipped.
  *
- * Setting the last channel will set the channelSetDone flag.
+ * value
+ * =======
+ * CHANNELVALUE_MID   0
+ * CHANNELVALUE_MIN   -1250 == -125%  == -500
+ * CHANNELVALUE_MAX    1250 ==  125%  ==  500
  *
- * SO SET THE LAST CHANNEL LAST !!
+ * To:
  *
+ * ppmTiming_t
+ * ===========
+ * PPM_MID_usec        ((timingUsec_t) 1500)
+ * PPM_MIN_usec        (PPM_MID_usec - PPM_RANGE_usec) = 900
+ * PPM_MAX_usec        (PPM_MID_usec + PPM_RANGE_usec) = 2100
  */
-void OutputImpl::SetChannelValue(int channel, int value) {
+static inline timingUsec_t toPulse( channelValue_t value) {
 
-    timingUsec_t t;
+    timingUsec_t t = PPM_MID_usec + (value * 2 / 5);
 
-    /* Convert:
-     *
-     * value
-     * =======
-     * CHANNELVALUE_MID   0
-     * CHANNELVALUE_MIN   -1250 == -125%  == -500
-     * CHANNELVALUE_MAX    1250 ==  125%  ==  500
-     *
-     * To:
-     *
-     * ppmTiming_t
-     * ===========
-     * PPM_MID_usec        ((timingUsec_t) 1500)
-     * PPM_MIN_usec        (PPM_MID_usec - PPM_RANGE_usec) = 900
-     * PPM_MAX_usec        (PPM_MID_usec + PPM_RANGE_usec) = 2100
-     *
-     */
+    if (t < PPM_MIN_usec) t = PPM_MIN_usec;
+    if (t > PPM_MAX_usec) t = PPM_MAX_usec;
 
-    if (channel < PPM_CHANNELS) {
+    return t;
+}
 
-        t = PPM_MID_usec + (value * 2 / 5);
+/* Set the timing of all channels and mark the set as done.
+ *
+ * The interrupt routine does not touch the modifiable set as long as
+ * channelSetDone is false. So the set is filled outside of the critical
+ * section. Only setting channelSetDone takes ppmMux, which also orders
+ * the writes for the other core.
+ *
+ * Does nothing if the last set has not been switched to yet.
+ */
+void OutputImpl::SetChannelValues( const channelValue_t values[]) {
 
-        if (t < PPM_MIN_usec) t = PPM_MIN_usec;
-        if (t > PPM_MAX_usec) t = PPM_MAX_usec;
+    if (channelSetDone) {
+        return;
+    }
 
-        portENTER_CRITICAL(&ppmMux);
-        ppmSet[OTHER_PPMSET(currentSet)].channel[channel] = t;
+    timingUsec_t *channel = ppmSet[OTHER_PPMSET(currentSet)].channel;
 
-        if (channel == PPM_CHANNELS - 1) {
-            channelSetDone = true;
-        }
-        portEXIT_CRITICAL(&ppmMux);
+    for (channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        channel[ch] = toPulse( values[ch]);
     }
+
+    portENTER_CRITICAL(&ppmMux);
+    channelSetDone = true;
+    portEXIT_CRITICAL(&ppmMux);
 }
@@ -30,6 +30,10 @@
 #include "TXos.h"
 #include "Controls.h"
 
+#ifdef ENABLE_RMT_PPM
+#include <driver/rmt.h>
+#endif
+
 #define PPM_PORT            15
 
 /*
@@ -54,6 +58,9 @@
 
 
 #define PPM_FRAME_usec      ((timingUsec_t) PPM_FRAME_TIME_usec)
+#ifdef ENABLE_ADAPTIVE_PPM
+#define PPM_SYNC_usec       ((timingUsec_t) PPM_SYNC_GAP_usec)
+#endif
 #define PPM_SPACE_usec      ((timingUsec_t)  400)
 #define PPM_MID_usec        ((timingUsec_t) 1500)
 
@@ -70,6 +77,15 @@
 
 #define OTHER_PPMSET( s)    (((s) +1) % 2)
 
+#ifdef ENABLE_RMT_PPM
+#define PPM_RMT_CHANNEL     RMT_CHANNEL_0
+
+/* One item per channel, one for the sync gap and the end marker.
+ * Must fit into one RMT memory block of 64 items.
+ */
+#define PPM_RMT_ITEMS       (PPM_CHANNELS + 2)
+#endif
+
 typedef struct ppmSet_t {
     
     timingUsec_t channel[ PPM_CHANNELS ];
@@ -82,24 +98,62 @@ class OutputImpl
         ppmSet_t ppmSet[2];
         uint8_t currentSet;
 
+#ifdef ENABLE_RMT_PPM
+        /* The frame in RMT format. Filled by encodeFrame() */
+        rmt_item32_t rmtItems[PPM_RMT_ITEMS];
+
+        void encodeFrame();
+#endif
+
     private:
         /* Count how may times the user mode code was unable to compute 
          * and set all channels within one PPM frame.
          * This should always be 0.
          */
         uint16_t ppmOverrun;
-        bool channelSetDone;
+        volatile bool channelSetDone;
+
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* ADC snapshot time of both sets */
+        unsigned long inputTime_usec[2];
+        /* Age of the input of the set switched to last */
+        volatile uint32_t latency_usec;
+        volatile bool latencyValid;
+#endif
+
+#ifdef ENABLE_JIT_SCHEDULING
+        /* Expected micros() of the next switchSet() */
+        volatile unsigned long nextSwitch_usec;
+#endif
     	
     public:
         OutputImpl();
 
         void switchSet();
 
+        /* True if the modifiable set is complete and waits for
+         * the switch at the next frame start.
+         */
+        bool isChannelSetDone() const;
         bool acceptChannels();
-        void SetChannelValue( int channel, int value);
+        void SetChannelValues( const channelValue_t values[]);
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* Set the ADC snapshot time of the next set.
+         * Must be called before SetChannelValues().
+         */
+        void SetInputTime( unsigned long t);
+        /* Returns true and the latency if a new set was switched to
+         * since the last call.
+         */
+        bool getLatency( uint32_t &usec);
+#endif
+#ifdef ENABLE_JIT_SCHEDULING
+        unsigned long getNextSwitchTime();
+#endif
         
         timingUsec_t getInFrameTime();
         timingUsec_t getMaxFrameTime();
+        timingUsec_t getMinFrameTime();
         uint16_t getOverrunCounter();
         
     private:
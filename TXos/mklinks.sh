@@ -35,7 +35,7 @@ for SOURCEDIR in $SOURCE ; do
     done
 done
 
-rm Arduino.h TXosTest.cpp TXosUnitTest.cpp TXosUnittestConfig.h
+rm Arduino.h TXosTest.cpp TXosUnitTest.cpp TXosBench.cpp TXosUnittestConfig.h
 
 mv TXos.cpp TXos.ino
 
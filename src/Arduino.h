@@ -57,6 +57,7 @@ typedef bool boolean;
 #define delay( s)
 
 extern unsigned long millis();
+extern unsigned long micros();
 extern EmuSerial Serial;
 
 /* From AVR atomic.h */
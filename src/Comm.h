@@ -97,6 +97,20 @@
  * Block Type = M
  * Identifier = Model number
  * 
+ * Module Profile (ENABLE_MODULE_PROFILER only)
+ * --------------
+ * Block Type = PR
+ * TU (Numeric) Profiler ticks per microsecond
+ * Sub block MP for each module of the run list:
+ *   ID (Numeric) Module type
+ *   TN, TV, TX (Numeric) Min, avg and max ticks of Module::run()
+ * 
+ * Latency (ENABLE_LATENCY_STATISTICS only)
+ * -------
+ * Block Type = LY
+ * LN, LV, LX (Numeric) Min, avg and max stick to pulse latency in usec
+ * LH (Numeric array) Latency histogram, 4 msec per bucket
+ * 
  * 
  * API
  * ====
@@ -143,6 +157,10 @@ using COMM_RC_t = uint8_t;
 #define COMM_PACKET_ERROR                 PACKET_TYPE('E','R')
 #define COMM_PACKET_MODELCONFIG           PACKET_TYPE('M','C')
 #define COMM_PACKET_SYSCONFIG             PACKET_TYPE('S','C')
+#define COMM_PACKET_GET_PROFILE           PACKET_TYPE('G','P')
+#define COMM_PACKET_PROFILE               PACKET_TYPE('P','R')
+#define COMM_PACKET_GET_LATENCY           PACKET_TYPE('G','L')
+#define COMM_PACKET_LATENCY               PACKET_TYPE('L','Y')
 
 /* This marks modules that do not need import/export */
 #define COMM_SUBPACKET_NONE               PACKET_TYPE('\0','\0')
@@ -173,6 +191,8 @@ using COMM_RC_t = uint8_t;
 #define COMM_SUBPACKET_TIMER              PACKET_TYPE('T','I')
 #define COMM_SUBPACKET_VCC_MONITOR        PACKET_TYPE('V','M')
 
+#define COMM_SUBPACKET_MODULE_PROFILE     PACKET_TYPE('M','P')
+
 #define COMM_FIELD_ID                     FIELD_TYPE('I','D')
 #define COMM_FIELD_CHANNEL                FIELD_TYPE('C','H')
 #define COMM_FIELD_CHANNEL_ARRAY          FIELD_TYPE('C','A')
@@ -188,6 +208,8 @@ using COMM_RC_t = uint8_t;
 #define COMM_FIELD_STATEA_ARRAY           FIELD_TYPE('S','A')
 #define COMM_FIELD_STATEB_ARRAY           FIELD_TYPE('T','A')
 #define COMM_FIELD_STATEC_ARRAY           FIELD_TYPE('U','A')
+#define COMM_FIELD_STATED_ARRAY           FIELD_TYPE('Y','A')
+#define COMM_FIELD_TRUTH_TABLE_ARRAY      FIELD_TYPE('L','T')
 #define COMM_FIELD_LOW_ARRAY              FIELD_TYPE('L','O')
 #define COMM_FIELD_MID_ARRAY              FIELD_TYPE('M','I')
 #define COMM_FIELD_HIGH_ARRAY             FIELD_TYPE('H','I')
@@ -211,6 +233,18 @@ using COMM_RC_t = uint8_t;
 /* Info packer */
 #define COMM_FIELD_VERSION                FIELD_TYPE('V','N')
 
+/* Profile packet */
+#define COMM_FIELD_TICKS_PER_USEC         FIELD_TYPE('T','U')
+#define COMM_FIELD_TICKS_MIN              FIELD_TYPE('T','N')
+#define COMM_FIELD_TICKS_AVG              FIELD_TYPE('T','V')
+#define COMM_FIELD_TICKS_MAX              FIELD_TYPE('T','X')
+
+/* Latency packet */
+#define COMM_FIELD_LATENCY_MIN            FIELD_TYPE('L','N')
+#define COMM_FIELD_LATENCY_AVG            FIELD_TYPE('L','V')
+#define COMM_FIELD_LATENCY_MAX            FIELD_TYPE('L','X')
+#define COMM_FIELD_LATENCY_HIST           FIELD_TYPE('L','H')
+
 #define COMM_CHAR_OPEN                      '{'
 #define COMM_CHAR_CLOSE                     '}'
 #define COMM_CHAR_SUBOPEN                   '{'
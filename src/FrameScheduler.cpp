@@ -0,0 +1,103 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "FrameScheduler.h"
+
+#ifdef ENABLE_JIT_SCHEDULING
+
+#include "InputImpl.h"
+#include "Output.h"
+
+extern InputImpl *inputImpl;
+extern Output output;
+
+FrameScheduler::FrameScheduler() {
+
+    acquireTime_usec = 0;
+    computeTime_usec = 0;
+    acquireStart_usec = 0;
+    computeStart_usec = 0;
+    acquiring = false;
+
+    /* Learn the estimates in immediate mode */
+    fallbackFrames = JIT_FALLBACK_FRAMES;
+    lastOverrun = 0;
+}
+
+/* Take a longer time at once, otherwise decay by 1/64 per frame. */
+timingUsec_t FrameScheduler::estimate( timingUsec_t est, unsigned long t) {
+
+    if( t >= est) {
+        return t > UINT16_MAX ? UINT16_MAX : (timingUsec_t)t;
+    }
+
+    return est - (est >> 6);
+}
+
+bool FrameScheduler::isDue() {
+
+    unsigned long now = micros();
+
+    if( !acquiring) {
+        if( fallbackFrames == 0) {
+            long remaining = (long)(output.getNextSwitchTime() - now);
+
+            if( remaining > (long)acquireTime_usec + computeTime_usec + JIT_SAFETY_MARGIN_usec) {
+                return false;
+            }
+        }
+
+        inputImpl->start();
+        acquireStart_usec = now;
+        acquiring = true;
+    }
+
+    if( !inputImpl->isAcquired()) {
+        return false;
+    }
+
+    acquiring = false;
+    acquireTime_usec = estimate( acquireTime_usec, now - acquireStart_usec);
+    computeStart_usec = now;
+
+    return true;
+}
+
+void FrameScheduler::computed() {
+
+    uint16_t overrun = output.getOverrunCounter();
+
+    computeTime_usec = estimate( computeTime_usec, micros() - computeStart_usec);
+
+    if( overrun != lastOverrun) {
+        lastOverrun = overrun;
+        fallbackFrames = JIT_FALLBACK_FRAMES;
+    } else if( fallbackFrames > 0) {
+        fallbackFrames--;
+    }
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/*
+    Just in time frame scheduling.
+
+    Without it the channels are computed as soon as the output accepts
+    the next set. That is right after the previous frame started, up to
+    a full frame before the new set is sent.
+
+    The scheduler delays ADC acquisition and the channel computation
+    until
+
+        next frame start - acquisition time - computation time - margin
+
+    Acquisition and computation time are measured every frame. The
+    estimate follows a longer run at once and decays slowly after that.
+    JIT_SAFETY_MARGIN_usec is left for interrupts and jitter of loop().
+
+    An output overrun switches to immediate mode for JIT_FALLBACK_FRAMES
+    frames. Immediate mode is also used after start until the first
+    estimates are available.
+
+    The scheduler owns the ADC start. The output interrupt and 
+    handle_channels() do not start acquisition with ENABLE_JIT_SCHEDULING.
+
+    Enable with ENABLE_JIT_SCHEDULING in TXosLocalConfig.h
+ */
+
+#ifndef _FrameScheduler_h_
+#define _FrameScheduler_h_
+
+#include "Controls.h"
+
+#ifdef ENABLE_JIT_SCHEDULING
+
+class FrameScheduler {
+
+    private:
+        /* Estimated time from start() to a complete ADC snapshot */
+        timingUsec_t acquireTime_usec;
+        /* Estimated time of the channel computation */
+        timingUsec_t computeTime_usec;
+
+        unsigned long acquireStart_usec;
+        unsigned long computeStart_usec;
+        bool acquiring;
+
+        /* Frames left in immediate mode */
+        uint8_t fallbackFrames;
+        uint16_t lastOverrun;
+
+        static timingUsec_t estimate( timingUsec_t est, unsigned long t);
+
+    public:
+        FrameScheduler();
+
+        /* Called when the output accepts channels.
+         * Returns true if the channels should be computed now.
+         */
+        bool isDue();
+
+        /* Called after the channels are set. */
+        void computed();
+
+        bool isImmediate() const { return fallbackFrames > 0; }
+};
+
+#endif
+#endif
@@ -0,0 +1,254 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "MixProgram.h"
+
+#ifdef ENABLE_MIX_PROGRAM
+
+#include "ModuleManager.h"
+#include "Model.h"
+#include "Mixer.h"
+
+extern ModuleManager moduleManager;
+
+/* Compile Model, Mixer and PhasesTrim in execution order. */
+void MixProgram::compile() {
+
+    opCount = 0;
+    modelMix = false;
+    Controls::conditionInit( diffCond);
+    Controls::conditionAdd( diffCond, SWITCH_UNUSED_FLAG);
+    diffPct = 0;
+
+    Model *model = (Model*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_MODEL_TYPE);
+    Mixer *mixer = (Mixer*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_MIXER_TYPE);
+    PhasesTrim *phasesTrim = (PhasesTrim*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_PHASES_TRIM_TYPE);
+
+    if( model) {
+        model->compileMix( *this);
+    }
+    if( mixer) {
+        mixer->compileMix( *this);
+    }
+    if( phasesTrim) {
+        phasesTrim->compileMix( *this);
+    }
+
+    valid = true;
+
+    LOGV("MixProgram::compile(): %d ops\n", opCount);
+}
+
+/* Differential is only possible if the percentage is not 0 and a switch is assigned. */
+void MixProgram::setWingMix( uint8_t wm, switch_t sw, percent_t pct) {
+
+    modelMix = true;
+    wingMix = wm;
+
+    if( pct != 0 && IS_SWITCH_USED( sw)) {
+        Controls::conditionInit( diffCond);
+        Controls::conditionAdd( diffCond, sw);
+        diffPct = pct;
+    }
+}
+
+mixOp_t *MixProgram::emitMix( switch_t sw, channel_t src, percent_t pct, percent_t offsetPct) {
+
+    if( opCount >= MIXPROGRAM_MAX_OPS) {
+        LOG("** MixProgram::emitMix(): ERROR: program full\n");
+        return nullptr;
+    }
+
+    mixOp_t *o = &op[opCount++];
+
+    o->flags = 0;
+    Controls::conditionInit( o->cond);
+    Controls::conditionAdd( o->cond, sw);
+    o->src = src;
+    o->pct = pct;
+    o->offset = PCT_TO_CHANNEL( offsetPct);
+    o->targets = 0;
+
+    return o;
+}
+
+mixOp_t *MixProgram::emitOffset( percent_t offsetPct) {
+
+    mixOp_t *o = emitMix( SWITCH_UNUSED_FLAG, 0, 0, offsetPct);
+
+    if( o) {
+        o->flags = MIXOP_F_CONST;
+        /* No trigger, always met */
+        Controls::conditionInit( o->cond);
+    }
+
+    return o;
+}
+
+void MixProgram::addTarget( mixOp_t *o, channel_t ch, bool subtract) {
+
+    if( o == nullptr || o->targets >= MIXOP_MAX_TARGETS || ch >= LOGICAL_CHANNELS) {
+        return;
+    }
+
+    if( subtract) {
+        o->flags |= MIXOP_F_NEG( o->targets);
+    }
+
+    o->target[o->targets++] = ch;
+}
+
+void MixProgram::run( Controls &controls) {
+
+    channelValue_t *ch = controls.logicalChannels();
+    channelValue_t saved[CHANNEL_SPOILER +1];
+
+    channelValue_t v;
+    channelValue_t trim;
+    channelValue_t reduction;
+    long d;
+
+    if( !valid) {
+        compile();
+    }
+
+    /* Switches do not change while the program runs */
+    bool diff = diffPct != 0 && controls.evalCondition( diffCond);
+
+    /* Wing mix. Same as Model::run() */
+
+    if( modelMix) {
+
+        /* original unmixed values */
+        memcpy( saved, ch, sizeof( saved));
+
+        ch[CHANNEL_FLAP2] = ch[CHANNEL_FLAP];
+        ch[CHANNEL_SPOILER2] = ch[CHANNEL_SPOILER];
+
+        switch( wingMix) {
+
+        case WINGMIX_DELTA:
+            if( diff) {
+                trim = controls.trimChannels()[CHANNEL_AILERON];
+                d = saved[CHANNEL_AILERON] - trim;
+                reduction = (channelValue_t)(d * (100L - abs(diffPct)) / 100L);
+
+                if( (diffPct > 0) == (d > 0) ) {
+                    ch[CHANNEL_AILERON] = Controls::limit( saved[CHANNEL_ELEVATOR] + saved[CHANNEL_AILERON]);
+                    ch[CHANNEL_ELEVATOR] = Controls::limit( saved[CHANNEL_ELEVATOR] - trim - reduction);
+                } else {
+                    ch[CHANNEL_AILERON] = Controls::limit( saved[CHANNEL_ELEVATOR] + trim + reduction);
+                    ch[CHANNEL_ELEVATOR] = Controls::limit( saved[CHANNEL_ELEVATOR] - saved[CHANNEL_AILERON]);
+                }
+            } else {
+                ch[CHANNEL_AILERON] = Controls::limit( saved[CHANNEL_ELEVATOR] + saved[CHANNEL_AILERON]);
+                ch[CHANNEL_ELEVATOR] = Controls::limit( saved[CHANNEL_ELEVATOR] - saved[CHANNEL_AILERON]);
+            }
+            break;
+
+        case WINGMIX_VTAIL:
+            ch[CHANNEL_RUDDER] = Controls::limit( saved[CHANNEL_ELEVATOR] + saved[CHANNEL_RUDDER]);
+            ch[CHANNEL_ELEVATOR] = Controls::limit( saved[CHANNEL_ELEVATOR] - saved[CHANNEL_RUDDER]);
+
+            [[fallthrough]];
+
+        case WINGMIX_NORMAL:
+            if( diff) {
+                trim = controls.trimChannels()[CHANNEL_AILERON];
+                d = saved[CHANNEL_AILERON] - trim;
+                reduction = (channelValue_t)(d * (100L - abs(diffPct)) / 100L);
+
+                if( (diffPct > 0) == (d > 0) ) {
+                    ch[CHANNEL_AILERON] = saved[CHANNEL_AILERON];
+                    ch[CHANNEL_AILERON2] = Controls::limit( -trim - reduction);
+                } else {
+                    ch[CHANNEL_AILERON] = Controls::limit( trim + reduction);
+                    ch[CHANNEL_AILERON2] = Controls::limit( -saved[CHANNEL_AILERON]);
+                }
+            } else {
+                ch[CHANNEL_AILERON2] = Controls::limit( -saved[CHANNEL_AILERON]);
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    /* Mixes and trims */
+
+    for( const mixOp_t *o = op; o < op + opCount; o++) {
+
+        const uint8_t flags = o->flags;
+
+        if( !controls.evalCondition( o->cond)) {
+            continue;
+        }
+
+        if( flags & MIXOP_F_CONST) {
+            v = o->offset;
+        } else {
+            v = (flags & MIXOP_F_SAVED) ? saved[o->src] : ch[o->src];
+            if( flags & MIXOP_F_ABS) {
+                v = abs( v);
+            }
+            v = (channelValue_t)( ((int32_t)v - o->offset) * o->pct / 100);
+        }
+
+        if( diff && (flags & MIXOP_F_FLAPDIFF)) {
+            trim = controls.trimChannels()[CHANNEL_AILERON];
+            d = v - trim;
+            reduction = (channelValue_t)(d * (100L - abs(diffPct)) / 100L);
+
+            if( (diffPct > 0) == (d > 0) ) {
+                ch[CHANNEL_FLAP] = Controls::limit( ch[CHANNEL_FLAP] + v);
+                ch[CHANNEL_FLAP2] = Controls::limit( ch[CHANNEL_FLAP2] - trim - reduction);
+            } else {
+                ch[CHANNEL_FLAP] = Controls::limit( ch[CHANNEL_FLAP] + trim + reduction);
+                ch[CHANNEL_FLAP2] = Controls::limit( ch[CHANNEL_FLAP2] - v);
+            }
+            continue;
+        }
+
+        /* Read the targets once. Writes to ch[] may alias the operation. */
+        const uint8_t targets = o->targets;
+        const channel_t t0 = o->target[0];
+        const channel_t t1 = o->target[1];
+        const channel_t t2 = o->target[2];
+
+        if( targets > 0) {
+            ch[t0] = Controls::limit( (flags & MIXOP_F_NEG(0)) ? ch[t0] - v : ch[t0] + v);
+        }
+        if( targets > 1) {
+            ch[t1] = Controls::limit( (flags & MIXOP_F_NEG(1)) ? ch[t1] - v : ch[t1] + v);
+        }
+        if( targets > 2) {
+            ch[t2] = Controls::limit( (flags & MIXOP_F_NEG(2)) ? ch[t2] - v : ch[t2] + v);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,133 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/*
+    The compiled mixing section.
+
+    Model, Mixer and PhasesTrim run back to back and only add, subtract
+    and copy logical channels. Instead of re-reading their configuration
+    every frame, each of them compiles its current configuration into a
+    list of uniform mix operations (see compileMix() of these modules).
+    Model::run() executes the wing mix and the whole list in one pass 
+    over the logical channels.
+
+    Unused mixes and zero trims are not compiled. Only mix switches and 
+    the aileron differential switch are evaluated per frame. Each of them
+    is compiled into a switch condition that is checked with a single
+    mask and compare.
+
+    The program is rebuilt on the next run after invalidate(). It is
+    invalidated on model load, on any change of the three modules
+    and on a phase switch.
+
+    Results are identical to running the three modules. Every write to a
+    logical channel is limited to CHANNELVALUE_MIN_LIMIT/CHANNELVALUE_MAX_LIMIT
+    as in Controls::logicalSet().
+
+    Enable with ENABLE_MIX_PROGRAM in TXosLocalConfig.h
+ */
+
+#ifndef _MixProgram_h_
+#define _MixProgram_h_
+
+#include "Controls.h"
+#include "PhasesTrim.h"
+
+#ifdef ENABLE_MIX_PROGRAM
+
+/* Flags of a mix operation */
+#define MIXOP_F_CONST       ((uint8_t)0x02)     // Add offset instead of a mixed value
+#define MIXOP_F_SAVED       ((uint8_t)0x04)     // Read unmixed src value saved before the wing mix
+#define MIXOP_F_ABS         ((uint8_t)0x08)     // Use absolute src value
+#define MIXOP_F_FLAPDIFF    ((uint8_t)0x10)     // Aileron differential on flaps, if enabled
+#define MIXOP_F_NEG( t)     ((uint8_t)(0x20 << (t)))  // Subtract from target t
+
+#define MIXOP_MAX_TARGETS   3
+
+/* mixed = (src - offset) * pct / 100
+ * target[t] += mixed   or  target[t] -= mixed
+ */
+typedef struct mixOp_t {
+
+    uint8_t flags;
+    switchCondition_t cond;
+    channel_t src;
+    percent_t pct;
+    channelValue_t offset;
+    uint8_t targets;
+    channel_t target[MIXOP_MAX_TARGETS];
+
+} mixOp_t;
+
+/* One operation per model mix, mixer and phased trim channel */
+#define MIXPROGRAM_MAX_OPS  (TEXT_MIX_count + MIXER + PHASED_TRIM_CHANNELS)
+
+class MixProgram {
+
+    private:
+        /* Model wing mix, executed before the operations */
+        bool modelMix = false;
+        uint8_t wingMix;
+
+        /* Aileron differential */
+        switchCondition_t diffCond;
+        percent_t diffPct;
+
+        mixOp_t op[MIXPROGRAM_MAX_OPS];
+        uint8_t opCount = 0;
+
+        bool valid = false;
+
+        void compile();
+
+    public:
+        MixProgram() = default;
+
+        /* Rebuild the program before the next run. */
+        void invalidate() { valid = false; }
+
+        uint8_t getOpCount() const { return opCount; }
+
+        /* Used by compileMix() of the modules */
+
+        void setWingMix( uint8_t wm, switch_t sw, percent_t pct);
+
+        /* Append a switched mix operation. Returns nullptr if the program is full.
+         * Mixes with an unused switch are never executed and should not be emitted.
+         */
+        mixOp_t *emitMix( switch_t sw, channel_t src, percent_t pct, percent_t offsetPct);
+
+        /* Append an operation that always adds a fixed offset. */
+        mixOp_t *emitOffset( percent_t offsetPct);
+
+        void addTarget( mixOp_t *o, channel_t ch, bool subtract);
+
+        void run( Controls &controls);
+};
+
+#endif
+
+#endif
@@ -82,6 +82,18 @@ class ImportExport;
 #define MODULE_LOGIC_SWITCH_TYPE        ((moduleType_t)67)
 #define MODULE_ANALOG_TRIM_TYPE         ((moduleType_t)68)
 
+/* Type ranges of both sets.
+ * Used by ModuleManager to size the lookup tables.
+ * Update when adding a module type.
+ */
+#define MODULE_SYSTEM_TYPE_FIRST        MODULE_MODEL_SELECT_TYPE
+#define MODULE_SYSTEM_TYPE_LAST         MODULE_IMPORTEXPORT_TYPE
+#define MODULE_SYSTEM_TYPE_COUNT        (MODULE_SYSTEM_TYPE_LAST - MODULE_SYSTEM_TYPE_FIRST + 1)
+
+#define MODULE_MODEL_TYPE_FIRST         MODULE_MODEL_TYPE
+#define MODULE_MODEL_TYPE_LAST          MODULE_ANALOG_TRIM_TYPE
+#define MODULE_MODEL_TYPE_COUNT         (MODULE_MODEL_TYPE_LAST - MODULE_MODEL_TYPE_FIRST + 1)
+
 /***** Configuration definition macros *****/
 
 #define NO_CONFIG()                                 \
@@ -152,6 +164,16 @@ class Module : public TextUIScreen {
         Module *runlistNext = nullptr;
         Module *setNext = nullptr;
 
+        bool active = true;
+
+    protected:
+        /* Returns false if run() does not change any channel or switch
+         * with the current configuration. Inactive modules are skipped
+         * by the module manager and the module pipeline.
+         * Modules with a pass-through configuration override this.
+         */
+        virtual bool checkActive() { return true; }
+
     public:
         Module( moduleType_t mType, const char *name, nameType_t cType);
         friend class ModuleManager;
@@ -159,7 +181,7 @@ class Module : public TextUIScreen {
         /* */
         virtual void run( Controls &controls) = 0;
 
-        /* Called after model load */
+        /* Called after model or system config load */
         virtual void init() { /* noop */ }
 
         /* Called when module is entered from menu */
@@ -183,6 +205,12 @@ class Module : public TextUIScreen {
         /* Returns the size of the modules configuration data. */
         virtual moduleSize_t getConfigSize() = 0;
 
+        /* Called when a stored configuration of a different size is loaded.
+         * A module that knows the older layout converts it into its
+         * configuration and returns true.
+         */
+        virtual bool migrateConfig( const uint8_t *config, moduleSize_t size) { return false; }
+
         /* Export configuration of a module as text to USB */
         virtual COMM_RC_t exportConfig( ImportExport *exporter, uint8_t *config) const = 0;
 
@@ -195,6 +223,16 @@ class Module : public TextUIScreen {
         /* Comm type for import/export */
         nameType_t getCommType() { return commType; }
 
+        /* Next module in the run list */
+        Module *getRunlistNext() const { return runlistNext; }
+
+        /* Recompute the active state. Called after init(), switchPhase()
+         * and setValue(). Not called per frame.
+         */
+        void updateActive() { active = checkActive(); }
+
+        bool isActive() const { return active; }
+
         /* From Interface TextUIScreen */
         bool goBackItem() { return true; }
         void activate(TextUI *ui);
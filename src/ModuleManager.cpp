@@ -29,8 +29,10 @@
 #include "Comm.h"
 #include "TextUI.h"
 #include "HomeScreen.h"
+#include "TaskScheduler.h"
 
 extern HomeScreen* homeScreen;
+extern TaskScheduler taskScheduler;
 
 ModuleManager::ModuleManager(ConfigBlock& svc) : blockService(&svc) {
 
@@ -62,6 +64,8 @@ TextUIMenu* ModuleManager::getModelMenu() {
 
 void ModuleManager::addToSystemSetAndMenu(Module* modulePtr) {
 
+    moduleType_t idx = modulePtr->getConfigType() - MODULE_SYSTEM_TYPE_FIRST;
+
     modulePtr->setNext = nullptr;
 
     if (systemSetFirst == nullptr) {
@@ -72,11 +76,21 @@ void ModuleManager::addToSystemSetAndMenu(Module* modulePtr) {
         systemSetLast = modulePtr;
     }
 
+    if (idx < MODULE_SYSTEM_TYPE_COUNT) {
+        systemByType[idx] = modulePtr;
+        addToCommTable(systemByComm, systemByCommCount, modulePtr);
+    }
+    else {
+        LOGV("** ModuleManager::addToSystemSetAndMenu(): ERROR: module type %d out of range\n", modulePtr->getConfigType());
+    }
+
     addToSystemMenu(modulePtr);
 }
 
 void ModuleManager::addToModelSetAndMenu(Module* modulePtr) {
 
+    moduleType_t idx = modulePtr->getConfigType() - MODULE_MODEL_TYPE_FIRST;
+
     modulePtr->setNext = nullptr;
 
     if (modelSetFirst == nullptr) {
@@ -87,29 +101,73 @@ void ModuleManager::addToModelSetAndMenu(Module* modulePtr) {
         modelSetLast = modulePtr;
     }
 
+    if (idx < MODULE_MODEL_TYPE_COUNT) {
+        modelByType[idx] = modulePtr;
+        addToCommTable(modelByComm, modelByCommCount, modulePtr);
+    }
+    else {
+        LOGV("** ModuleManager::addToModelSetAndMenu(): ERROR: module type %d out of range\n", modulePtr->getConfigType());
+    }
+
     addToModelMenu(modulePtr);
 }
 
-bool ModuleManager::inSystemSet(Module* modulePtr) {
-    Module* m = systemSetFirst;
+/* Insert a module into a table sorted by comm type.
+ * Modules without a comm type are not added.
+ * The table has room for one module per type of the set.
+ */
+void ModuleManager::addToCommTable(Module* table[], uint8_t& count, Module* modulePtr) {
+
+    nameType_t type = modulePtr->getCommType();
+    uint8_t i = count;
+
+    if (type == COMM_SUBPACKET_NONE) {
+        return;
+    }
 
-    while (m != nullptr) {
-        if (m == modulePtr) return true;
-        m = m->setNext;
+    while (i > 0 && table[i - 1]->getCommType() > type) {
+        table[i] = table[i - 1];
+        i--;
     }
 
-    return false;
+    table[i] = modulePtr;
+    count++;
 }
 
-bool ModuleManager::inModelSet(Module* modulePtr) {
-    Module* m = modelSetFirst;
+/* Binary search in a table sorted by comm type. */
+Module* ModuleManager::findInCommTable(Module* const table[], uint8_t count, nameType_t type) {
 
-    while (m != nullptr) {
-        if (m == modulePtr) return true;
-        m = m->setNext;
+    uint8_t lo = 0;
+    uint8_t hi = count;
+    uint8_t mid;
+    nameType_t t;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        t = table[mid]->getCommType();
+
+        if (t == type) {
+            return table[mid];
+        }
+        else if (t < type) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
     }
 
-    return false;
+    return nullptr;
+}
+
+bool ModuleManager::inSystemSet(Module* modulePtr) {
+
+    return getModuleByType(MODULE_SET_SYSTEM, modulePtr->getConfigType()) == modulePtr;
+}
+
+bool ModuleManager::inModelSet(Module* modulePtr) {
+
+    return getModuleByType(MODULE_SET_MODEL, modulePtr->getConfigType()) == modulePtr;
 }
 
 void ModuleManager::addToRunList(Module* modulePtr) {
@@ -125,46 +183,16 @@ void ModuleManager::addToRunList(Module* modulePtr) {
     }
 }
 
-Module* ModuleManager::getModuleByType(uint8_t setType, moduleType_t type) {
-
-    Module* current = nullptr;
-
-    if (setType == MODULE_SET_MODEL) {
-        current = modelSetFirst;
-    }
-    else if (setType == MODULE_SET_SYSTEM) {
-        current = systemSetFirst;
-    }
-
-    while (current != nullptr) {
-        if (current->getConfigType() == type) {
-            break;
-        }
-        current = current->setNext;
-    }
-
-    return current;
-}
-
-Module* ModuleManager::getModuleByCommType(uint8_t setType, nameType_t type) {
-
-    Module* current = nullptr;
+Module* ModuleManager::getModuleByCommType(uint8_t setType, nameType_t type) const {
 
     if (setType == MODULE_SET_MODEL) {
-        current = modelSetFirst;
+        return findInCommTable(modelByComm, modelByCommCount, type);
     }
     else if (setType == MODULE_SET_SYSTEM) {
-        current = systemSetFirst;
+        return findInCommTable(systemByComm, systemByCommCount, type);
     }
 
-    while (current != nullptr) {
-        if (current->getCommType() == type) {
-            break;
-        }
-        current = current->setNext;
-    }
-
-    return current;
+    return nullptr;
 }
 
 /* Copy memory form "payload" into "p".
@@ -238,15 +266,38 @@ uint8_t ModuleManager::parseModule(configBlockID_t modelID, Module& moduleRef) {
 /*
  * Call the run() method of each module in the list
  * and pass the reference to the channel set.
+ * Inactive modules are skipped.
  */
-void ModuleManager::runModules(Controls& controls) {
+uint8_t ModuleManager::runModules(Controls& controls) {
 
     Module* current = runlistFirst;
+    uint8_t count = 0;
 
+#ifdef ENABLE_MODULE_PROFILER
+    uint8_t idx = 0;
+    profileTicks_t start;
+
+    while (current != nullptr) {
+        if (current->isActive()) {
+            start = ModuleProfiler::start();
+            current->run(controls);
+            profiler.record(idx, current, ModuleProfiler::elapsed(start));
+            count++;
+        }
+        idx++;
+        current = current->runlistNext;
+    }
+#else
     while (current != nullptr) {
-        current->run(controls);
+        if (current->isActive()) {
+            current->run(controls);
+            count++;
+        }
         current = current->runlistNext;
     }
+#endif
+
+    return count;
 }
 
 /* Notify all modules about a phase switch.
@@ -260,6 +311,7 @@ void ModuleManager::switchPhase(phase_t phase) {
 
     while (current != nullptr) {
         current->switchPhase(phase);
+        current->updateActive();
         current = current->setNext;
     }
 }
@@ -303,6 +355,23 @@ void ModuleManager::initModel() {
 
     while (current != nullptr) {
         current->init();
+        current->updateActive();
+        current = current->setNext;
+    }
+}
+
+/* Initialize all system modules.
+ * This is called after system config load.
+ */
+void ModuleManager::initSystem() {
+
+    LOG("\nModuleManager::initSystem():\n");
+
+    Module* current = systemSetFirst;
+
+    while (current != nullptr) {
+        current->init();
+        current->updateActive();
         current = current->setNext;
     }
 }
@@ -392,6 +461,8 @@ void ModuleManager::loadSystemConfig(configBlockID_t blockID) {
         setSystemDefaults();
         saveSystemConfig(blockID);
     }
+
+    initSystem();
 }
 
 /*
@@ -450,7 +521,7 @@ void ModuleManager::exportSystemConfig(ImportExport* exporter) {
         else {
             module->exportConfig(exporter, buffer);
             comm.writePart();
-            yieldLoop();
+            taskScheduler.yield();
         }
 
         GET((uint8_t*)&type, sizeof(moduleType_t));
@@ -460,6 +531,39 @@ void ModuleManager::exportSystemConfig(ImportExport* exporter) {
     comm.write();
 }
 
+#ifdef ENABLE_MODULE_PROFILER
+void ModuleManager::exportProfile(ImportExport* exporter) {
+
+    LOG("ModuleManager::exportProfile(): called\n");
+
+    const moduleProfile_t* p;
+    Comm& comm = exporter->getComm();
+
+    comm.open(COMM_PACKET_PROFILE);
+    comm.addUInt16(COMM_FIELD_TICKS_PER_USEC, profiler.getTicksPerUsec());
+    comm.writePart();
+
+    for (uint8_t idx = 0; idx < profiler.getCount(); idx++) {
+        p = profiler.getProfile(idx);
+        if (p->module == nullptr) {
+            continue;
+        }
+
+        comm.openSub(COMM_SUBPACKET_MODULE_PROFILE);
+        comm.addUInt8(COMM_FIELD_ID, p->module->getConfigType());
+        comm.addUInt32(COMM_FIELD_TICKS_MIN, p->minTicks);
+        comm.addUInt32(COMM_FIELD_TICKS_AVG, profiler.getAvgTicks(idx));
+        comm.addUInt32(COMM_FIELD_TICKS_MAX, p->maxTicks);
+        comm.close();
+        comm.writePart();
+        taskScheduler.yield();
+    }
+
+    comm.close();
+    comm.write();
+}
+#endif
+
 void ModuleManager::importSystemConfig(ImportExport* importer) {
 
     LOG("ModuleManager::importSystemConfig(): called\n");
@@ -523,7 +627,7 @@ void ModuleManager::exportModel(ImportExport* exporter, configBlockID_t modelID)
         else {
             module->exportConfig(exporter, buffer);
             comm.writePart();
-            yieldLoop();
+            taskScheduler.yield();
         }
 
         GET((uint8_t*)&type, sizeof(moduleType_t));
@@ -681,9 +785,15 @@ void ModuleManager::parseBlock(uint8_t setType) {
 
         }
         else if (current->getConfigSize() != size) {
-            LOGV("** ModuleManager::parseBlock(): ERROR: Config size mismatch of module type=%d %d != %d\n",
-                type, current->getConfigSize(), size);
-            homeScreen->postMessage(1, MSG_CONFIG_SIZE);
+            if (current->migrateConfig(payload, size)) {
+                LOGV("ModuleManager::parseBlock(): Migrated config of module type=%d size %d -> %d\n",
+                    type, size, current->getConfigSize());
+            }
+            else {
+                LOGV("** ModuleManager::parseBlock(): ERROR: Config size mismatch of module type=%d %d != %d\n",
+                    type, current->getConfigSize(), size);
+                homeScreen->postMessage(1, MSG_CONFIG_SIZE);
+            }
             payload += size;
             totalSize += size;
 
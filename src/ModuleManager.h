@@ -43,6 +43,7 @@
 #include "TXos.h"
 #include "Module.h"
 #include "ConfigBlock.h"
+#include "ModuleProfiler.h"
 
 #define MODULE_SET_SYSTEM     1
 #define MODULE_SET_MODEL      2
@@ -66,8 +67,25 @@ class ModuleManager {
         Module *modelSetFirst = nullptr;
         Module *modelSetLast = nullptr;
 
+        /* Modules of each set indexed by module type - <SET>_TYPE_FIRST */
+        Module *systemByType[MODULE_SYSTEM_TYPE_COUNT] = {};
+        Module *modelByType[MODULE_MODEL_TYPE_COUNT] = {};
+
+        /* Modules of each set with a comm type, sorted by comm type */
+        Module *systemByComm[MODULE_SYSTEM_TYPE_COUNT];
+        Module *modelByComm[MODULE_MODEL_TYPE_COUNT];
+        uint8_t systemByCommCount = 0;
+        uint8_t modelByCommCount = 0;
+
         ConfigBlock *blockService;
 
+#ifdef ENABLE_MODULE_PROFILER
+        ModuleProfiler profiler;
+#endif
+
+        static void addToCommTable( Module *table[], uint8_t &count, Module *modulePtr);
+        static Module *findInCommTable( Module *const table[], uint8_t count, nameType_t type);
+
         void parseBlock( uint8_t setType);
         void generateBlock( configBlockID_t modelID, uint8_t setType);
 
@@ -84,21 +102,42 @@ class ModuleManager {
         bool inModelSet( Module *modulePtr);
 
         void addToRunList( Module *modulePtr);
+        Module *getRunlistFirst() const { return runlistFirst; }
 
-        Module *getModuleByType( uint8_t setType, moduleType_t type);
-        Module *getModuleByCommType( uint8_t setType, nameType_t type);
+        /* Called on every frame by some modules. Keep it inline. */
+        Module *getModuleByType( uint8_t setType, moduleType_t type) const {
+
+            if( setType == MODULE_SET_MODEL) {
+                type -= MODULE_MODEL_TYPE_FIRST;
+                return (type < MODULE_MODEL_TYPE_COUNT) ? modelByType[type] : nullptr;
+            } else if( setType == MODULE_SET_SYSTEM) {
+                type -= MODULE_SYSTEM_TYPE_FIRST;
+                return (type < MODULE_SYSTEM_TYPE_COUNT) ? systemByType[type] : nullptr;
+            }
+
+            return nullptr;
+        }
+
+        Module *getModuleByCommType( uint8_t setType, nameType_t type) const;
 
         TextUIMenu *getSystemMenu();
         TextUIMenu *getModelMenu();
         
         uint8_t parseModule( configBlockID_t modelID, Module &moduleRef);
 
-        void runModules( Controls &controls);
+        /* Returns the number of active modules that were run. */
+        uint8_t runModules( Controls &controls);
+
+#ifdef ENABLE_MODULE_PROFILER
+        ModuleProfiler *getProfiler() { return &profiler; }
+        void exportProfile( ImportExport *exporter);
+#endif
 
         void switchPhase( phase_t phase);
         void setModelDefaults();
         void setSystemDefaults();
         void initModel();
+        void initSystem();
 
         uint8_t getModelCount() const;
 
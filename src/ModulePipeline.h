@@ -0,0 +1,96 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/*
+    A module pipeline with an execution order fixed at compile time.
+
+    The module types of all stages are template parameters.
+    Every stage is called through its own type. The call is resolved 
+    at compile time and can be inlined, instead of walking the 
+    run list with one indirect call per module and frame.
+
+    All Module::run() implementations are declared final, so 
+    calling a stage through its type never changes behaviour.
+
+    The run list of ModuleManager is still filled from the pipeline
+    (see addToRunList()). It is used by the module profiler.
+ */
+
+#ifndef _ModulePipeline_h_
+#define _ModulePipeline_h_
+
+#include "Controls.h"
+#include "ModuleManager.h"
+
+template< typename... Stages >
+class ModulePipeline;
+
+/* End of pipeline */
+template<>
+class ModulePipeline<> {
+
+    public:
+        ModulePipeline() = default;
+
+        inline uint8_t run( Controls &controls) { return 0; }
+
+        void addToRunList( ModuleManager &manager) { /* noop */ }
+};
+
+template< typename Stage, typename... Stages >
+class ModulePipeline< Stage, Stages... > {
+
+    private:
+        Stage *stage;
+        ModulePipeline< Stages... > next;
+
+    public:
+        explicit ModulePipeline( Stage *s, Stages*... rest) : stage( s), next( rest...) {}
+
+        /* Run all active stages. Returns the number of stages run. */
+        inline uint8_t run( Controls &controls) {
+
+            uint8_t count = 0;
+
+            if( stage->isActive()) {
+                stage->Stage::run( controls);
+                count = 1;
+            }
+
+            return count + next.run( controls);
+        }
+
+        /* Add all stages to the run list of the module manager
+         * in pipeline order.
+         */
+        void addToRunList( ModuleManager &manager) {
+
+            manager.addToRunList( stage);
+            next.addToRunList( manager);
+        }
+};
+
+#endif
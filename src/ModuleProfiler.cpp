@@ -0,0 +1,110 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "ModuleProfiler.h"
+
+#ifdef ENABLE_MODULE_PROFILER
+
+ModuleProfiler::ModuleProfiler() {
+
+    reset();
+}
+
+void ModuleProfiler::init() {
+
+#if defined( ARDUINO_ARCH_AVR )
+    /* Timer 5: Normal mode, no prescaler */
+    TCCR5A = 0;
+    TCCR5B = _BV( CS50);
+    TIMSK5 = 0;
+    ticksPerUsec = F_CPU / 1000000L;
+#elif defined( ARDUINO_ARCH_ESP32 )
+    ticksPerUsec = getCpuFrequencyMhz();
+#else
+    ticksPerUsec = 1000;
+#endif
+
+    reset();
+}
+
+void ModuleProfiler::reset() {
+
+    for( uint8_t i = 0; i < PROFILER_MAX_MODULES; i++) {
+        profile[i].module = nullptr;
+        profile[i].minTicks = 0;
+        profile[i].maxTicks = 0;
+        profile[i].sumTicks = 0;
+        profile[i].count = 0;
+    }
+    moduleCount = 0;
+}
+
+void ModuleProfiler::record( uint8_t idx, Module *module, profileTicks_t ticks) {
+
+    if( idx >= PROFILER_MAX_MODULES) {
+        return;
+    }
+
+    moduleProfile_t *p = &profile[idx];
+
+    if( p->module != module) {
+        /* First run or run list changed */
+        p->module = module;
+        p->minTicks = PROFILE_TICKS_MAX;
+        p->maxTicks = 0;
+        p->sumTicks = 0;
+        p->count = 0;
+
+        if( idx >= moduleCount) {
+            moduleCount = idx +1;
+        }
+    }
+
+    if( ticks < p->minTicks) {
+        p->minTicks = ticks;
+    }
+    if( ticks > p->maxTicks) {
+        p->maxTicks = ticks;
+    }
+
+    /* Keep the average moving instead of overflowing */
+    if( p->count == UINT16_MAX || p->sumTicks > UINT32_MAX - ticks) {
+        p->sumTicks /= 2;
+        p->count /= 2;
+    }
+
+    p->sumTicks += ticks;
+    p->count++;
+}
+
+profileTicks_t ModuleProfiler::getAvgTicks( uint8_t idx) const {
+
+    const moduleProfile_t *p = &profile[idx];
+
+    return p->count == 0 ? 0 : (profileTicks_t)(p->sumTicks / p->count);
+}
+
+#endif
@@ -0,0 +1,131 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/*
+    Optional per module run time profiler.
+
+    Measures every Module::run() call of ModuleManager::runModules()
+    and keeps min/avg/max per module of the run list.
+
+    Time source:
+      AVR       Timer 5 running at CPU clock (TCNT5). 
+                A single run() must not take longer than 4ms (65536 cycles),
+                longer runs are reported as 65535.
+      ESP32     CPU cycle counter.
+      Emulation steady_clock with nanosecond ticks.
+
+    Enable with ENABLE_MODULE_PROFILER in TXosLocalConfig.h
+ */
+
+#ifndef _ModuleProfiler_h_
+#define _ModuleProfiler_h_
+
+#include "TXos.h"
+
+#ifdef ENABLE_MODULE_PROFILER
+
+#if !defined( ARDUINO )
+#include <chrono>
+#endif
+
+class Module;
+
+#if defined( ARDUINO_ARCH_AVR )
+typedef uint16_t profileTicks_t;
+#define PROFILE_TICKS_MAX     UINT16_MAX
+#else
+typedef uint32_t profileTicks_t;
+#define PROFILE_TICKS_MAX     UINT32_MAX
+#endif
+
+/* Max. number of modules in the run list */
+#define PROFILER_MAX_MODULES  ((uint8_t)32)
+
+typedef struct moduleProfile_t {
+
+    Module *module;
+
+    profileTicks_t minTicks;
+    profileTicks_t maxTicks;
+    uint32_t sumTicks;
+    uint16_t count;
+
+} moduleProfile_t;
+
+class ModuleProfiler {
+
+    private:
+        moduleProfile_t profile[PROFILER_MAX_MODULES];
+        uint8_t moduleCount = 0;
+        uint16_t ticksPerUsec = 1;
+
+    public:
+        ModuleProfiler();
+
+        /* Start the time source. 
+         * Must be called from setup(). On AVR the Arduino core 
+         * reconfigures all timers before setup() is called.
+         */
+        void init();
+        void reset();
+
+        /* Start a measurement */
+        static inline profileTicks_t start() {
+#if defined( ARDUINO_ARCH_AVR )
+            TIFR5 = _BV( TOV5);
+            return TCNT5;
+#elif defined( ARDUINO_ARCH_ESP32 )
+            return ESP.getCycleCount();
+#else
+            return (profileTicks_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+        }
+
+        /* Ticks elapsed since start */
+        static inline profileTicks_t elapsed( profileTicks_t startTicks) {
+#if defined( ARDUINO_ARCH_AVR )
+            profileTicks_t now = TCNT5;
+            /* Timer overflow and counter past start value: More than one full timer period. */
+            if( (TIFR5 & _BV( TOV5)) && now >= startTicks) {
+                return PROFILE_TICKS_MAX;
+            }
+            return now - startTicks;
+#else
+            return start() - startTicks;
+#endif
+        }
+
+        void record( uint8_t idx, Module *module, profileTicks_t ticks);
+
+        uint8_t getCount() const { return moduleCount; }
+        const moduleProfile_t *getProfile( uint8_t idx) const { return &profile[idx]; }
+        profileTicks_t getAvgTicks( uint8_t idx) const;
+        uint16_t getTicksPerUsec() const { return ticksPerUsec; }
+};
+
+#endif
+#endif
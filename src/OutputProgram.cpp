@@ -0,0 +1,155 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "OutputProgram.h"
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+
+#include "ModuleManager.h"
+#include "ServoRemap.h"
+#include "ServoReverse.h"
+#include "ServoSubtrim.h"
+#include "ServoLimit.h"
+#include "ServoTest.h"
+
+extern ModuleManager moduleManager;
+
+/* Compile ServoRemap, ServoReverse, ServoSubtrim and ServoLimit. */
+void OutputProgram::compile() {
+
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        op[ch].src = OUTPUTOP_SRC_NONE;
+        op[ch].reverse = false;
+        op[ch].offset = 0;
+        op[ch].min = CHANNELVALUE_MIN_LIMIT;
+        op[ch].max = CHANNELVALUE_MAX_LIMIT;
+    }
+
+    ServoRemap *remap = (ServoRemap*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_SERVO_REMAP_TYPE);
+    ServoReverse *reverse = (ServoReverse*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_SERVO_REVERSE_TYPE);
+    ServoSubtrim *subtrim = (ServoSubtrim*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_SERVO_SUBTRIM_TYPE);
+    ServoLimit *limit = (ServoLimit*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_SERVO_LIMIT_TYPE);
+
+    if( remap) {
+        remap->compileOutput( *this);
+    }
+    if( reverse) {
+        reverse->compileOutput( *this);
+    }
+    if( subtrim) {
+        subtrim->compileOutput( *this);
+    }
+    if( limit) {
+        limit->compileOutput( *this);
+    }
+
+    valid = true;
+
+    LOGV("OutputProgram::compile()\n");
+}
+
+void OutputProgram::setSource( channel_t ch, channel_t src) {
+
+    op[ch].src = (src < LOGICAL_CHANNELS) ? src : OUTPUTOP_SRC_NONE;
+}
+
+void OutputProgram::setReverse( channel_t ch) {
+
+    op[ch].reverse = true;
+}
+
+void OutputProgram::setOffset( channel_t ch, percent_t pct) {
+
+    op[ch].offset = PCT_TO_CHANNEL( pct);
+}
+
+/* Same as ServoLimit::run():
+ * The value is limited to CHANNELVALUE_MIN_LIMIT/CHANNELVALUE_MAX_LIMIT,
+ * then to the positive and then to the negative limit. So the negative
+ * limit wins if it is above the positive one.
+ */
+void OutputProgram::setLimits( channel_t ch, percent_t negPct, percent_t posPct) {
+
+    channelValue_t min = Controls::limit( PCT_TO_CHANNEL( negPct));
+    channelValue_t max = Controls::limit( PCT_TO_CHANNEL( posPct));
+
+    if( max < min) {
+        max = min;
+    }
+
+    op[ch].min = min;
+    op[ch].max = max;
+}
+
+static inline channelValue_t clamp( channelValue_t v, const outputOp_t *o) {
+
+    if( v > o->max) {
+        return o->max;
+    }
+
+    if( v < o->min) {
+        return o->min;
+    }
+
+    return v;
+}
+
+void OutputProgram::run( Controls &controls) {
+
+    const channelValue_t *logical = controls.logicalChannels();
+    channelValue_t *output = controls.outputChannels();
+    const outputOp_t *o;
+    channelValue_t v;
+
+    if( !valid) {
+        compile();
+    }
+
+#ifdef ENABLE_SERVOTEST_MODULE
+    if( servoTest != nullptr && servoTest->isTesting()) {
+
+        for( o = op; o < op + PPM_CHANNELS; o++) {
+            v = (o->src == OUTPUTOP_SRC_NONE) ? CHANNELVALUE_MID : logical[o->src];
+            output[o - op] = (o->reverse ? -v : v) + o->offset;
+        }
+
+        servoTest->ServoTest::run( controls);
+
+        for( o = op; o < op + PPM_CHANNELS; o++) {
+            output[o - op] = clamp( output[o - op], o);
+        }
+
+        return;
+    }
+#endif
+
+    for( o = op; o < op + PPM_CHANNELS; o++) {
+        v = (o->src == OUTPUTOP_SRC_NONE) ? CHANNELVALUE_MID : logical[o->src];
+        output[o - op] = clamp( (o->reverse ? -v : v) + o->offset, o);
+    }
+}
+
+#endif
@@ -0,0 +1,106 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/*
+    The compiled output section.
+
+    ServoRemap, ServoReverse, ServoSubtrim and ServoLimit only depend on
+    the model configuration. Each of them compiles its configuration into
+    one operation per output channel (see compileOutput() of these modules):
+
+        out = clamp( sign * logical[src] + offset, min, max)
+
+    ServoRemap::run() executes the operations in one pass from the logical
+    to the output channels. ServoReverse, ServoSubtrim and ServoLimit are
+    reported inactive.
+
+    ServoTest runs between subtrim and limit. If a servo test is running
+    it is called as an override hook between the two halves of the pass,
+    so the test still obeys the servo limits.
+
+    The program is rebuilt on the next run after invalidate(). It is
+    invalidated on model load and on any change of the four modules.
+
+    Results are identical to running the four modules.
+
+    Enable with ENABLE_OUTPUT_PROGRAM in TXosLocalConfig.h
+ */
+
+#ifndef _OutputProgram_h_
+#define _OutputProgram_h_
+
+#include "Controls.h"
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+
+class ServoTest;
+
+/* Read CHANNELVALUE_MID instead of a logical channel */
+#define OUTPUTOP_SRC_NONE   LOGICAL_CHANNELS
+
+typedef struct outputOp_t {
+
+    channel_t src;
+    bool reverse;
+    channelValue_t offset;
+    channelValue_t min;
+    channelValue_t max;
+
+} outputOp_t;
+
+class OutputProgram {
+
+    private:
+        outputOp_t op[PPM_CHANNELS];
+
+        ServoTest *servoTest = nullptr;
+
+        bool valid = false;
+
+        void compile();
+
+    public:
+        OutputProgram() = default;
+
+        /* Rebuild the program before the next run. */
+        void invalidate() { valid = false; }
+
+        /* Called instead of the ServoTest stage while a test is running */
+        void setOverride( ServoTest *test) { servoTest = test; }
+
+        /* Used by compileOutput() of the modules */
+
+        void setSource( channel_t ch, channel_t src);
+        void setReverse( channel_t ch);
+        void setOffset( channel_t ch, percent_t pct);
+        void setLimits( channel_t ch, percent_t negPct, percent_t posPct);
+
+        void run( Controls &controls);
+};
+
+#endif
+
+#endif
@@ -103,9 +103,9 @@
  * Timer 0   8 bit       Arduino micros() millis() delay()...
  * Timer 1  16 bit       Buzzer Sound      BuzzerImpl.cpp
  * Timer 2   8 bit 
- * Timer 3  16 bit       PPM generation    OutputImpl.cpp
+ * Timer 3  16 bit       PPM generation    OutputImpl.cpp (not used with HF_SBUS)
  * Timer 4  16 bit 
- * Timer 5  16 bit 
+ * Timer 5  16 bit       Module profiler   ModuleProfiler.cpp (ENABLE_MODULE_PROFILER only)
  * 
  * 
  * 
@@ -240,6 +240,12 @@
 
 #include "ImportExport.h"
 
+#include "ModulePipeline.h"
+#include "MixProgram.h"
+#include "OutputProgram.h"
+#include "FrameScheduler.h"
+#include "TaskScheduler.h"
+
 #ifdef ARDUINO
 
 #ifdef ARDUINO_ARCH_AVR
@@ -257,6 +263,10 @@
 #include "PortsImpl.h"
 #include "BuzzerImpl.h"
 
+#if HF_MODULE == HF_SBUS
+#include "SerialOutput.h"
+#endif
+
 #else
 
 #include "DisplayImpl.h"
@@ -311,6 +321,30 @@ const char* OutputChannelNames[PPM_CHANNELS] = {
     TEXT_OUT_CH_7,
     TEXT_OUT_CH_8,
     TEXT_OUT_CH_9
+/* Only HF_SBUS takes PPM_CHANNELS from the local config. */
+#if HF_MODULE == HF_SBUS
+#if PPM_CHANNELS > 9
+    ,TEXT_OUT_CH_10
+#endif
+#if PPM_CHANNELS > 10
+    ,TEXT_OUT_CH_11
+#endif
+#if PPM_CHANNELS > 11
+    ,TEXT_OUT_CH_12
+#endif
+#if PPM_CHANNELS > 12
+    ,TEXT_OUT_CH_13
+#endif
+#if PPM_CHANNELS > 13
+    ,TEXT_OUT_CH_14
+#endif
+#if PPM_CHANNELS > 14
+    ,TEXT_OUT_CH_15
+#endif
+#if PPM_CHANNELS > 15
+    ,TEXT_OUT_CH_16
+#endif
+#endif
 };
 
 const char *PhaseNames[TEXT_PHASES_count] = {
@@ -331,7 +365,8 @@ const char *LogicTypes[TEXT_LOGIC_SW_TYPE_count] = {
     TEXT_LOGIC_SW_TYPE3,
     TEXT_LOGIC_SW_TYPE4,
     TEXT_LOGIC_SW_TYPE5,
-    TEXT_LOGIC_SW_TYPE6
+    TEXT_LOGIC_SW_TYPE6,
+    TEXT_LOGIC_SW_TYPE7
 };
 
 /* Make sure the entries are in the same order as the 
@@ -388,6 +423,10 @@ OutputImpl *outputImpl;
 PortsImpl *portsImpl;
 BuzzerImpl *buzzerImpl;
 
+#if HF_MODULE == HF_SBUS
+SerialOutput *serialOutput;
+#endif
+
 /* Serial required for Import/Export module since V0.4.3 */
 #define ENABLE_SERIAL
 #define ENABLE_MEMDEBUG
@@ -475,6 +514,18 @@ SystemConfig systemConfig;
 ModelSelect modelSelect;
 ModuleManager moduleManager( configBlock);
 
+#ifdef ENABLE_MIX_PROGRAM
+MixProgram mixProgram;
+#endif
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+OutputProgram outputProgram;
+#endif
+
+#ifdef ENABLE_JIT_SCHEDULING
+FrameScheduler frameScheduler;
+#endif
+
 HomeScreen *homeScreen;
 
 #ifdef UI_EXTERNAL_USERTERM_DISPLAY
@@ -486,20 +537,56 @@ ReliableStream *stream;
 Statistics statistics;
 uint16_t lastOverrun = UINT16_MAX;
 uint16_t wdLastReset;
+uint16_t uiTime_msec;
+/* Time spent in other tasks while rendering, not counted as UI time */
+unsigned long renderYield_msec;
 #endif
 
 #ifdef ENABLE_SERVOTEST_MODULE
 ServoTest servotest;
+#define SERVOTEST_STAGE       ServoTest,
+#define SERVOTEST_STAGE_PTR   &servotest,
+#else
+#define SERVOTEST_STAGE
+#define SERVOTEST_STAGE_PTR
 #endif
 
+/* The order of modules is important.
+ * It defines the order of execution in handle_channels().
+ */
+typedef ModulePipeline<
+    /* The following moduels act on analog input channels */
+    CalibrateSticks, CalibrateTrim, SwitchedChannels, ChannelReverse, AnalogSwitch,
+    /* The following moduels act on logical channels */
+    AssignInput, ChannelDelay, Phases, LogicSwitch, DualExpo, ChannelRange, AnalogTrim,
+    Model, Mixer, PhasesTrim, EngineCut,
+    /* The following modules act on output (servo) channels */
+    ServoRemap, ServoReverse, ServoSubtrim, SERVOTEST_STAGE ServoLimit,
+    /* The follow moduels do not impact channel values */
+    ServoMonitor, SwitchMonitor, Timer, VccMonitor, ImportExport
+> pipeline_t;
+
+pipeline_t *pipeline;
+
 #ifdef ENABLE_BDEBUG
 uint8_t bdebugi = 0;
 char bdebug[ BDEBUG_LEN ];
 #endif
 
-unsigned long nextScreenUpdate = 0L;
+ImportExport *importExport;
+
+TaskScheduler taskScheduler;
+
 const unsigned int SCREEN_UPDATE_msec = 50; // Limit screen update frequency
 
+bool channelTask();
+bool commTask();
+bool uiTask();
+bool renderHook();
+#ifdef ENABLE_STATISTICS_MODULE
+bool statisticsTask();
+#endif
+
 void setup( void) {
 
 #ifdef ENABLE_BDEBUG
@@ -529,10 +616,18 @@ void setup( void) {
                                PORT_SWITCH_INPUT_COUNT, switchConfiguration,
                                SwitchPins);
 
+#if HF_MODULE == HF_SBUS
+    SERIAL_OUTPUT_BEGIN();
+    serialOutput = new SerialOutput( SERIAL_OUTPUT_PORT);
+#else
     outputImpl = new OutputImpl();
+#endif
    
 #endif
 
+    /* Needs the input implementation for the switch configuration. */
+    controls.init();
+
 
 #ifdef ARDUINO
 
@@ -567,7 +662,7 @@ void setup( void) {
     /* System menu */
     
     moduleManager.addToSystemSetAndMenu( &modelSelect);
-    ImportExport *importExport = new ImportExport( Serial);
+    importExport = new ImportExport( Serial);
     moduleManager.addToSystemSetAndMenu( importExport);
     ServoMonitor *servoMonitor = new ServoMonitor( controls);
     moduleManager.addToSystemSetAndMenu( servoMonitor);
@@ -641,54 +736,31 @@ void setup( void) {
     ServoLimit *servoLimit = new ServoLimit();
     moduleManager.addToModelSetAndMenu( servoLimit);
 
-    /* The order of modules is important.
-     * It defines the order of execution in RunModules().
-     */
+    /* Same order as the stages of pipeline_t */
+    pipeline = new pipeline_t( 
+        calibrateSticks, calibrateTrim, switchedChannels, channelReverse, analogSwitch,
+        assignInput, channelDelay, phases, logicSwitch, dualExpo, channelRange, analogTrim,
+        model, mixer, phasesTrim, engineCut,
+        servoRemap, servoReverse, servoSubtrim, SERVOTEST_STAGE_PTR servoLimit,
+        servoMonitor, switchMonitor, timer, vccMonitor, importExport);
 
-    /* The following moduels act on analog input channels */
-    moduleManager.addToRunList( calibrateSticks);
-    moduleManager.addToRunList( calibrateTrim);
-    moduleManager.addToRunList( switchedChannels);
-    moduleManager.addToRunList( channelReverse);
-    moduleManager.addToRunList( analogSwitch);
-    
-    /* The following moduels act on logical channels */
-    moduleManager.addToRunList( assignInput);
-    moduleManager.addToRunList( channelDelay);
-    // ### done until here
-    moduleManager.addToRunList( phases);
-    moduleManager.addToRunList( logicSwitch);
-    moduleManager.addToRunList( dualExpo);
-    moduleManager.addToRunList( channelRange);
-    moduleManager.addToRunList( analogTrim);
-    moduleManager.addToRunList( model);
-    moduleManager.addToRunList( mixer);
-    moduleManager.addToRunList( phasesTrim);
-    moduleManager.addToRunList( engineCut);
+    /* The run list is used by the profiler and if the static pipeline is disabled. */
+    pipeline->addToRunList( moduleManager);
 
-    /* The following modules act on output (servo) channels */
-    moduleManager.addToRunList( servoRemap);
-    moduleManager.addToRunList( servoReverse);
-    moduleManager.addToRunList( servoSubtrim);
-#ifdef ENABLE_SERVOTEST_MODULE
-    moduleManager.addToRunList( &servotest);
+#if defined( ENABLE_OUTPUT_PROGRAM ) && defined( ENABLE_SERVOTEST_MODULE )
+    outputProgram.setOverride( &servotest);
 #endif
-    moduleManager.addToRunList( servoLimit);
-
-    /* The follow moduels do not impact channel values */
-    moduleManager.addToRunList( servoMonitor);
-    moduleManager.addToRunList( switchMonitor);
-    moduleManager.addToRunList( timer);
-    moduleManager.addToRunList( vccMonitor);
-    moduleManager.addToRunList( importExport);
 
     userInterface.setHomeScreen( homeScreen);
+    userInterface.setRenderHook( renderHook);
 
     systemConfig.load();
 
     moduleManager.loadModel( modelSelect.getModelID());
 
-    controls.init();
+#ifdef ENABLE_MODULE_PROFILER
+    moduleManager.getProfiler()->init();
+#endif
 
 #if defined( ARDUINO_ARCH_AVR)
 #ifdef ENABLE_MEMDEBUG
@@ -701,6 +773,14 @@ void setup( void) {
 #endif
 #endif
 
+    /* Budgets in usec */
+    taskScheduler.addTask( channelTask, TASK_PRIO_REALTIME, 0, 2000);
+    taskScheduler.addTask( commTask, TASK_PRIO_COMM, 0, 5000);
+    taskScheduler.addTask( uiTask, TASK_PRIO_UI, SCREEN_UPDATE_msec, 5000);
+#ifdef ENABLE_STATISTICS_MODULE
+    taskScheduler.addTask( statisticsTask, TASK_PRIO_BACKGROUND, 0, 1000);
+#endif
+
     buzzer.play( SoundWelcome);
 
 #if (defined( ENABLE_BDEBUG) && defined( ENABLE_SERIAL))
@@ -710,15 +790,9 @@ void setup( void) {
 }
 
 void watchdog_reset();
-static void handle_channels();
 
 void loop( void) {
 
-    unsigned long now;
-#ifdef ENABLE_STATISTICS_MODULE
-    uint16_t overrun;
-#endif
-
 #if defined( ARDUINO_ARCH_AVR)
 
     set_sleep_mode( SLEEP_MODE_IDLE);
@@ -730,10 +804,6 @@ void loop( void) {
 
 #endif
 
-    watchdog_reset();
-    
-    handle_channels();
-
 #ifdef ARDUINO
 
 #ifdef ENABLE_BDEBUG
@@ -757,23 +827,74 @@ void loop( void) {
 
 #endif
 
-    now = millis();
+    taskScheduler.run();
+}
+
+/* Hard real-time: The next channel set must be ready before the frame starts. */
+bool channelTask() {
+
+    watchdog_reset();
+    handle_channels();
+
+    return false;
+}
+
+bool commTask() {
+
+    importExport->handleComm();
 
-    if( now >= nextScreenUpdate) {
-        userInterface.handle( userInterface.getEvent());
-        nextScreenUpdate = now + SCREEN_UPDATE_msec;
-    }
-    
 #ifdef UI_EXTERNAL_USERTERM_DISPLAY
     stream->handleComm();
 #endif
 
+    return false;
+}
+
+bool uiTask() {
+
+#ifdef ENABLE_STATISTICS_MODULE
+    unsigned long now = millis();
+    renderYield_msec = 0;
+#endif
+
+    userInterface.handle( userInterface.getEvent());
+
+#ifdef ENABLE_STATISTICS_MODULE
+    uiTime_msec = (uint16_t)(millis() - now - renderYield_msec);
+    statistics.updateUITime( uiTime_msec);
+#endif
+
+    /* Resume a paused screen update in the next round */
+    return userInterface.isRendering();
+}
+
+/* Called by the user interface between two render chunks.
+ * Let the channel task run and pause rendering when the
+ * UI task has used up its budget.
+ */
+bool renderHook() {
+
+#ifdef ENABLE_STATISTICS_MODULE
+    unsigned long now = millis();
+#endif
+
+    taskScheduler.yield();
+
+#ifdef ENABLE_STATISTICS_MODULE
+    renderYield_msec += millis() - now;
+#endif
+
+    return taskScheduler.isBudgetExceeded();
+}
+
 #ifdef ENABLE_STATISTICS_MODULE
-    now = millis() - now;
-    statistics.updateUITime( (uint16_t)now);
+bool statisticsTask() {
+
+    uint16_t overrun;
+
     overrun = output.getOverrunCounter();
     statistics.updatePPMOverrun( overrun);
-    statistics.updateFrameTime( output.getMaxFrameTime());
+    statistics.updateFrameTime( output.getMinFrameTime(), output.getMaxFrameTime());
 #ifdef ENABLE_MEMDEBUG
     statistics.updateMemFree( gapFree);
 #endif
@@ -782,21 +903,12 @@ void loop( void) {
         lastOverrun = overrun;
         homeScreen->printDebug( overrun);
     } else if( statistics.debugTiming()) {
-        homeScreen->printDebug( (uint16_t)now);
+        homeScreen->printDebug( uiTime_msec);
     }
-    
-#endif
-}
-
-void yieldLoop() {
 
-#ifdef ENABLE_SERIAL
-    Serial.flush();
-#endif
-
-    watchdog_reset();
-    handle_channels();
+    return false;
 }
+#endif
 
 void watchdog_reset() {
 
@@ -813,17 +925,43 @@ void watchdog_reset() {
 
 void handle_channels() {
   
+#ifdef ENABLE_JIT_SCHEDULING
+    if( output.acceptChannels() && frameScheduler.isDue() ) {
+#else
     if( output.acceptChannels() ) {
+#endif
+
+        uint8_t modulesRun;
 
 #ifdef ENABLE_STATISTICS_MODULE
         unsigned long now = millis();
 #endif
         controls.GetControlValues();
-        moduleManager.runModules( controls);
+#if defined( ENABLE_STATIC_PIPELINE ) && !defined( ENABLE_MODULE_PROFILER )
+        modulesRun = pipeline->run( controls);
+#else
+        modulesRun = moduleManager.runModules( controls);
+#endif
         output.setChannels( controls);
 
+#ifdef ENABLE_JIT_SCHEDULING
+        frameScheduler.computed();
+#elif defined( ARDUINO ) && HF_MODULE == HF_SBUS
+        /* There is no PPM timer to start the next ADC sequence. */
+        inputImpl->start();
+#endif
+
 #ifdef ENABLE_STATISTICS_MODULE
         statistics.updateModulesTime( (uint16_t)(millis() - now));
+        statistics.updateModulesRun( modulesRun);
+#ifdef ENABLE_LATENCY_STATISTICS
+        uint32_t latency;
+        if( output.getLatency( latency)) {
+            statistics.updateLatency( latency);
+        }
+#endif
+#else
+        (void)modulesRun;
 #endif
     }
 }
@@ -59,7 +59,7 @@
     #define LOGV( f, ... )
 #endif
 
-extern void yieldLoop();
+extern void handle_channels();
 
 /* Holds small float values with 2 fractional digits.
  * This is currently only used to display battery voltage.
@@ -101,7 +101,7 @@ typedef enum {
  *  6 Switch reflects all flight phases (3-state)
  * 
  * NOTE: If you add a switch type, please modify
- *       Controls::copySwitchName()
+ *       Controls::copySwitchName() and SW_CONF_COUNT
  */
 typedef enum {
 
@@ -115,6 +115,9 @@ typedef enum {
 
 } switchConf_t;
 
+/* Number of switch types */
+#define SW_CONF_COUNT ((uint8_t)7)
+
 #ifdef UNITTEST
   #include "TXosUnittestConfig.h"
 #else
@@ -0,0 +1,292 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/*
+ * Headless benchmark of the channel pipeline.
+ *
+ * Runs setup() from TXos.cpp against the stand-in HAL in bench/
+ * and then calls handle_channels() as fast as possible.
+ * Reports frames/sec and ns/frame for the complete pipeline
+ * and a breakdown per module of the run list.
+ *
+ * Usage: TXosBench [frames]
+ */
+
+#include "Arduino.h"
+
+#include "InputImpl.h"
+#include "DisplayImpl.h"
+#include "OutputImpl.h"
+#include "PortsImpl.h"
+#include "BuzzerImpl.h"
+
+#include "EEPROM.h"
+#include "EmuSerial.h"
+
+#include "ModuleManager.h"
+#include "Output.h"
+#include "Model.h"
+#include "Mixer.h"
+#include "DualExpo.h"
+#include "Phases.h"
+#include "PhasesTrim.h"
+#include "ChannelDelay.h"
+
+#include <chrono>
+
+using namespace std::chrono;
+
+EEPROMClass EEPROM(4096);
+EmuSerial Serial;
+
+extern void setup( void);
+
+extern Controls controls;
+extern Output output;
+extern ModuleManager moduleManager;
+
+InputImpl *inputImpl;
+OutputImpl *outputImpl;
+DisplayImpl *displayImpl;
+PortsImpl *portsImpl;
+BuzzerImpl *buzzerImpl;
+
+SWITCH_CONFIGURATION
+
+#define DEFAULT_FRAMES    1000000UL
+#define WARMUP_FRAMES       10000UL
+
+/* Max. number of modules in the run list */
+#define BENCH_MAX_MODULES      32
+
+/* Virtual clock. Advances by one PPM frame per benchmark frame
+ * so that time dependent modules behave the same on every run.
+ */
+static uint32_t benchFrame = 0;
+
+unsigned long millis() {
+
+    return (unsigned long)((uint64_t)benchFrame * PPM_FRAME_TIME_usec / 1000);
+}
+
+unsigned long micros() {
+
+    return (unsigned long)((uint64_t)benchFrame * PPM_FRAME_TIME_usec);
+}
+
+static void nextFrame() {
+
+    benchFrame++;
+    inputImpl->benchStep( benchFrame);
+}
+
+/* Configure a model that keeps most of the modules busy.
+ * Defaults leave many modules as a no-op.
+ */
+static void benchModel() {
+
+    dualExpo_t *dualExpo = (dualExpo_t*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_DUAL_EXPO_TYPE)->getConfig();
+    phasesTrim_t *phasesTrim = (phasesTrim_t*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_PHASES_TRIM_TYPE)->getConfig();
+    phases_t *phases = (phases_t*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_PHASES_TYPE)->getConfig();
+    model_t *model = (model_t*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_MODEL_TYPE)->getConfig();
+    mixer_t *mixer = (mixer_t*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_MIXER_TYPE)->getConfig();
+    channelDelay_t *channelDelay = (channelDelay_t*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_CHANNEL_DELAY_TYPE)->getConfig();
+
+    for( phase_t ph = 0; ph < PHASES; ph++) {
+        for( channel_t ch = 0; ch < DUAL_EXPO_CHANNELS; ch++) {
+            dualExpo[ph].expo[ch] = (percent_t)(20 + 10 * ph);
+            dualExpo[ph].rate[ch] = (percent_t)(100 - 10 * ph);
+        }
+        for( channel_t ch = 0; ch < PHASED_TRIM_CHANNELS; ch++) {
+            phasesTrim[ph].trim_pct[ch] = (percent_t)(ph * 3 - ch);
+        }
+    }
+
+    /* Phase selected by the first 3-state switch */
+    SET_SWITCH( phases->sw, controls.getSwitchByType( SW_CONF_3STATE, 0));
+    SET_SWITCH_USED( phases->sw);
+
+    model->qrDiffPct = 40;
+    SET_SWITCH( model->qrDiffSw, controls.getSwitchByType( SW_CONF_FIXED_ON, 0));
+    SET_SWITCH_STATE( model->qrDiffSw, SW_STATE_1);
+    SET_SWITCH_USED( model->qrDiffSw);
+
+    for( uint8_t mix = 0; mix < TEXT_MIX_count; mix++) {
+        SET_SWITCH( model->mixSw[mix], controls.getSwitchByType( SW_CONF_2STATE, mix % 2));
+        SET_SWITCH_STATE( model->mixSw[mix], SW_STATE_1);
+        SET_SWITCH_USED( model->mixSw[mix]);
+        model->mixPct[mix] = (percent_t)(10 + mix * 5);
+        model->mixOffset[mix] = (percent_t)(mix % 3);
+    }
+
+    for( uint8_t mix = 0; mix < MIXER; mix++) {
+        SET_SWITCH( mixer->mixSw[mix], controls.getSwitchByType( SW_CONF_FIXED_ON, 0));
+        SET_SWITCH_STATE( mixer->mixSw[mix], SW_STATE_1);
+        SET_SWITCH_USED( mixer->mixSw[mix]);
+        mixer->source[mix] = CHANNEL_ELEVATOR + mix;
+        mixer->target[mix] = CHANNEL_FLAP + mix;
+        mixer->mixPct[mix] = 25;
+        mixer->mixOffset[mix] = 0;
+    }
+
+    channelDelay->posDelay_sec[CHANNEL_FLAP] = 10;
+    channelDelay->negDelay_sec[CHANNEL_FLAP] = 5;
+
+    moduleManager.initModel();
+}
+
+static double nsPerFrame( nanoseconds ns, unsigned long frames) {
+
+    return (double)ns.count() / (double)frames;
+}
+
+int main( int argc, char **argv) {
+
+    unsigned long frames = DEFAULT_FRAMES;
+
+    if( argc > 1) {
+        frames = strtoul( argv[1], nullptr, 10);
+        if( frames == 0) {
+            printf("Usage: %s [frames]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    portsImpl = new PortsImpl();
+    buzzerImpl = new BuzzerImpl();
+    displayImpl = new DisplayImpl();
+    outputImpl = new OutputImpl( PPM_CHANNELS);
+    inputImpl =  new InputImpl( PORT_ANALOG_INPUT_COUNT, PORT_TRIM_INPUT_COUNT, PORT_AUX_INPUT_COUNT,
+                                PORT_SWITCH_INPUT_COUNT, switchConfiguration);
+
+    setup();
+    benchModel();
+
+    for( unsigned long f = 0; f < WARMUP_FRAMES; f++) {
+        nextFrame();
+        handle_channels();
+    }
+
+    /* Complete pipeline */
+
+    benchFrame = 0;
+    outputImpl->resetChecksum();
+
+    steady_clock::time_point start = steady_clock::now();
+
+    for( unsigned long f = 0; f < frames; f++) {
+        nextFrame();
+        handle_channels();
+    }
+
+    nanoseconds total = duration_cast<nanoseconds>( steady_clock::now() - start);
+
+    printf("TXos %s pipeline benchmark, %lu frames\n\n", TXOS_VERSION, frames);
+    printf("  %12.0f frames/sec\n", (double)frames * 1e9 / (double)total.count());
+    printf("  %12.1f ns/frame\n", nsPerFrame( total, frames));
+    printf("  %12.4f %% of %u usec frame\n", nsPerFrame( total, frames) / 10.0 / PPM_FRAME_TIME_usec, PPM_FRAME_TIME_usec);
+    printf("  %12.8x checksum\n\n", outputImpl->getChecksum());
+
+    /* Breakdown by module.
+     * Same sequence as handle_channels(), but each module is timed separately.
+     */
+
+    Module *modules[BENCH_MAX_MODULES];
+    nanoseconds moduleTime[BENCH_MAX_MODULES];
+    uint8_t moduleCount = 0;
+
+    for( Module *m = moduleManager.getRunlistFirst(); m != nullptr && moduleCount < BENCH_MAX_MODULES; m = m->getRunlistNext()) {
+        modules[moduleCount] = m;
+        moduleTime[moduleCount] = nanoseconds::zero();
+        moduleCount++;
+    }
+
+    /* Cost of one clock read. Subtracted from every stage. */
+    steady_clock::time_point t0 = steady_clock::now();
+    for( unsigned long f = 0; f < WARMUP_FRAMES; f++) {
+        steady_clock::now();
+    }
+    double clockOverhead = nsPerFrame( duration_cast<nanoseconds>( steady_clock::now() - t0), WARMUP_FRAMES);
+
+    nanoseconds inputTime = nanoseconds::zero();
+    nanoseconds outputTime = nanoseconds::zero();
+    steady_clock::time_point t1;
+
+    benchFrame = 0;
+
+    for( unsigned long f = 0; f < frames; f++) {
+        nextFrame();
+
+        t0 = steady_clock::now();
+        controls.GetControlValues();
+        t1 = steady_clock::now();
+        inputTime += t1 - t0;
+
+        for( uint8_t i = 0; i < moduleCount; i++) {
+            if( !modules[i]->isActive()) {
+                continue;
+            }
+            t0 = t1;
+            modules[i]->run( controls);
+            t1 = steady_clock::now();
+            moduleTime[i] += t1 - t0;
+        }
+
+        t0 = t1;
+        output.setChannels( controls);
+        t1 = steady_clock::now();
+        outputTime += t1 - t0;
+    }
+
+    printf("  %-16s %10s\n", "Stage", "ns/frame");
+    printf("  %-16s %10.1f\n", "GetControlValues", nsPerFrame( inputTime, frames) - clockOverhead);
+    for( uint8_t i = 0; i < moduleCount; i++) {
+        if( modules[i]->isActive()) {
+            printf("  %-16s %10.1f\n", modules[i]->getMenuName(), nsPerFrame( moduleTime[i], frames) - clockOverhead);
+        } else {
+            printf("  %-16s %10s\n", modules[i]->getMenuName(), "inactive");
+        }
+    }
+    printf("  %-16s %10.1f\n", "setChannels", nsPerFrame( outputTime, frames) - clockOverhead);
+    printf("\n  Clock overhead of %.1f ns subtracted from each stage.\n", clockOverhead);
+
+#ifdef ENABLE_MODULE_PROFILER
+    /* Results of the built-in profiler, collected during both runs above */
+    ModuleProfiler *profiler = moduleManager.getProfiler();
+
+    printf("\n  %-16s %8s %8s %8s (ticks, %u per usec)\n", "Profiler", "min", "avg", "max", profiler->getTicksPerUsec());
+    for( uint8_t i = 0; i < profiler->getCount(); i++) {
+        const moduleProfile_t *p = profiler->getProfile( i);
+        if( p->module == nullptr) {
+            continue;
+        }
+        printf("  %-16s %8lu %8lu %8lu\n", p->module->getMenuName(),
+               (unsigned long)p->minTicks, (unsigned long)profiler->getAvgTicks( i), (unsigned long)p->maxTicks);
+    }
+#endif
+
+    return 0;
+}
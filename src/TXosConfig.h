@@ -34,6 +34,7 @@
 /* Supported HF modules */
 #define HF_SPEKTRUM_PPM 1
 #define HF_JETI_TU2     2
+#define HF_SBUS         3
 
 #include "TXosLocalConfig.h"
 
@@ -145,6 +146,16 @@
     #undef ENABLE_BIND_MODULE
     #undef ENABLE_RANGETEST_MODULE
 
+#elif HF_MODULE == HF_SBUS
+    #undef ENABLE_BIND_MODULE
+    #undef ENABLE_RANGETEST_MODULE
+    /* The switch scanner runs from the PPM timer */
+    #undef ENABLE_SWITCH_SCANNER
+
+    /* TX2 = pin 16. Needs an external inverter. */
+    #define SERIAL_OUTPUT_PORT        Serial2
+    #define SERIAL_OUTPUT_BEGIN()     Serial2.begin( 100000, SERIAL_8E2)
+
 #else
   #error "Set HF_MODULE in TXosLocalConfig.h to a supported value."
 #endif
@@ -236,6 +247,14 @@
     #undef ENABLE_BIND_MODULE
     #undef ENABLE_RANGETEST_MODULE
 
+#elif HF_MODULE == HF_SBUS
+    #undef ENABLE_BIND_MODULE
+    #undef ENABLE_RANGETEST_MODULE
+
+    /* UART 2 TX on the PPM pin, inverted signal */
+    #define SERIAL_OUTPUT_PORT        Serial2
+    #define SERIAL_OUTPUT_BEGIN()     Serial2.begin( 100000, SERIAL_8E2, -1, 15, true)
+
 #else
   #error "Set HF_MODULE in TXosLocalConfig.h to a supported value."
 #endif
@@ -255,6 +274,43 @@
 #endif
 
 
+#if defined( ENABLE_LATENCY_STATISTICS ) && !defined( ENABLE_STATISTICS_MODULE )
+    #undef ENABLE_LATENCY_STATISTICS
+#endif
+
+/* The emulation has no frame timing to schedule against. */
+#if defined( ENABLE_JIT_SCHEDULING ) && !defined( ARDUINO )
+    #undef ENABLE_JIT_SCHEDULING
+#endif
+
+#ifdef ENABLE_JIT_SCHEDULING
+    #ifndef JIT_SAFETY_MARGIN_usec
+        #define JIT_SAFETY_MARGIN_usec    (2000)
+    #endif
+    #ifndef JIT_FALLBACK_FRAMES
+        #define JIT_FALLBACK_FRAMES       (50)
+    #endif
+#endif
+
+/* Time between two output frames */
+#if HF_MODULE == HF_SBUS
+    #ifndef SERIAL_FRAME_TIME_usec
+        #define SERIAL_FRAME_TIME_usec    (7000)
+    #endif
+    #if PPM_CHANNELS > 16
+        #error "HF_SBUS supports up to 16 channels"
+    #endif
+    #define OUTPUT_FRAME_TIME_usec        SERIAL_FRAME_TIME_usec
+#elif defined( ENABLE_ADAPTIVE_PPM )
+    #ifndef PPM_SYNC_GAP_usec
+        #define PPM_SYNC_GAP_usec         (4000)
+    #endif
+    /* Nominal frame time with all channels at mid position */
+    #define OUTPUT_FRAME_TIME_usec        (PPM_CHANNELS * 1500 + PPM_SYNC_GAP_usec)
+#else
+    #define OUTPUT_FRAME_TIME_usec        PPM_FRAME_TIME_usec
+#endif
+
 /* Voltage divider values in 1000Ohm units.*/
 #define ADC_VOLTAGE_DIVIDER_R1     22
 #define ADC_VOLTAGE_DIVIDER_R2     10
@@ -57,6 +57,11 @@
  * HF_JETI_TU2
  *   disable bind and range test module
  *   9 to 16 channels, but only 9 supported currently.
+ *
+ * HF_SBUS
+ *   serial SBUS output instead of PPM
+ *   disable bind and range test module
+ *   up to 16 channels, frame time SERIAL_FRAME_TIME_usec (4000 - 14000)
  */
 #define HF_MODULE                HF_SPEKTRUM_PPM
 
@@ -65,7 +70,7 @@
  * This is the number of channels that will be used to
  * generate the PPM signal.
  * MINIMUM = 4
- * MAXIMUM = 9
+ * MAXIMUM = 9, 16 for HF_SBUS
  */
 #define PPM_CHANNELS                  (9)
 #define PPM_FRAME_TIME_usec           (22000)
@@ -159,4 +164,76 @@ const switchConf_t switchConfiguration[SWITCHES] = { \
 #define ENABLE_BIND_MODULE
 #define ENABLE_RANGETEST_MODULE
 
+/* Run the modules through a pipeline with compile time dispatch
+ * instead of walking the run list with a virtual call per module.
+ * Ignored if ENABLE_MODULE_PROFILER is set.
+ */
+#define ENABLE_STATIC_PIPELINE
+
+/* Compile Model, Mixer and phased trims into one list of mix
+ * operations. Rebuilt on configuration or phase change.
+ */
+#define ENABLE_MIX_PROGRAM
+
+/* Compile servo remap, reverse, subtrim and limits into one
+ * operation per output channel. Rebuilt on configuration change.
+ */
+#define ENABLE_OUTPUT_PROGRAM
+
+/* Measure the run time of every module in the run list.
+ * Results are shown in the statistics module and can be 
+ * requested via import/export.
+ * Uses Timer 5 on ATmega2560.
+ */
+//#define ENABLE_MODULE_PROFILER
+
+/* Let the ADC run continuously through all analog inputs and
+ * average 2^ADC_OVERSAMPLING_SHIFT samples per input.
+ * Reduces stick jitter.
+ * ATmega2560: Costs one interrupt per conversion (about 100 usec).
+ * ESP32: Only inputs on ADC1 run in the background (ADC DMA driver).
+ *        Inputs on ADC2 are read one per frame.
+ */
+//#define ENABLE_ADC_OVERSAMPLING
+//#define ADC_OVERSAMPLING_SHIFT   3
+
+/* ATmega2560 only:
+ * Read all switches on port A at once from the PPM timer interrupt
+ * and debounce them. Requires all switch pins in range 22 - 29.
+ */
+//#define ENABLE_SWITCH_SCANNER
+
+/* ESP32 only:
+ * Generate the PPM signal with the RMT peripheral instead of a
+ * timer interrupt. Pulse edges are free of interrupt latency.
+ */
+//#define ENABLE_RMT_PPM
+
+/* End each PPM frame after a sync gap of PPM_SYNC_GAP_usec
+ * instead of padding to PPM_FRAME_TIME_usec.
+ * The frame time depends on the channel values. With 9 channels
+ * it is between 12.1 and 22.9 msec. The receiver must accept this.
+ */
+//#define ENABLE_ADAPTIVE_PPM
+//#define PPM_SYNC_GAP_usec        (4000)
+
+/* Measure the time from the ADC snapshot to the output frame
+ * that carries it. Min, avg, max and a histogram are shown in the
+ * statistics module and can be requested via import/export.
+ * Requires ENABLE_STATISTICS_MODULE.
+ */
+//#define ENABLE_LATENCY_STATISTICS
+
+/* Just in time frame scheduling.
+ * Start the ADC acquisition and the channel computation as late as
+ * possible before the next output frame instead of right after the
+ * previous one. JIT_SAFETY_MARGIN_usec is left between the end of the
+ * computation and the frame start. After an overrun the scheduler runs
+ * in immediate mode for JIT_FALLBACK_FRAMES frames.
+ * Hardware only, ignored by the emulation.
+ */
+//#define ENABLE_JIT_SCHEDULING
+//#define JIT_SAFETY_MARGIN_usec   (2000)
+//#define JIT_FALLBACK_FRAMES      (50)
+
 #endif
\ No newline at end of file
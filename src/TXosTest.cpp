@@ -61,6 +61,11 @@ unsigned long millis() {
     return (unsigned long)clock() * 1000 / CLOCKS_PER_SEC;
 }
 
+unsigned long micros() {
+
+    return (unsigned long)((uint64_t)clock() * 1000000 / CLOCKS_PER_SEC);
+}
+
 class TXosTest : public wxApp
 {
     public:
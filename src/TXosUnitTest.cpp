@@ -37,6 +37,7 @@
 #include "UtModules.h"
 
 EEPROMClass EEPROM(4096);
+EmuSerial Serial;
 
 InputImpl *inputImpl;
 OutputImpl *outputImpl;
@@ -53,6 +54,20 @@ unsigned long millis() {
     return (long)clock() * 1000 / CLOCKS_PER_SEC;
 }
 
+/* Tests of time dependent code set a fixed time in usec.
+ * 0 uses the process clock.
+ */
+unsigned long unittestMicros = 0;
+
+unsigned long micros() {
+
+    if( unittestMicros) {
+        return unittestMicros;
+    }
+
+    return (unsigned long)((uint64_t)clock() * 1000000 / CLOCKS_PER_SEC);
+}
+
 int main() {
     
     portsImpl = new PortsImpl();
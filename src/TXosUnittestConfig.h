@@ -35,7 +35,7 @@
  * This includes sticks, other analog inputs and
  * switched channels.
  */
-#define ANALOG_CHANNELS               ((channel_t)9)
+#define ANALOG_CHANNELS               (9)
 /* Input Channels:
  * ANALOG_CHANNELS plus one that decouples the channel from input.
  */
@@ -60,13 +60,18 @@
  * This is the number of channels that will be used to
  * generate the PPM signal.
  */
-#define PPM_CHANNELS                  ((channel_t)9)
+#define PPM_CHANNELS                  (9)
 #define PPM_FRAME_TIME_MSEC           (22)
+#define PPM_FRAME_TIME_usec           (22000)
+
+/* Time between two output frames */
+#define OUTPUT_FRAME_TIME_usec        PPM_FRAME_TIME_usec
 
 /* Total number of switches. Max is 16.
  * This includes channel switches and logical switches.
+ * Plain number, it is tested in #if.
  */
-#define SWITCHES                      ((uint8_t)13)
+#define SWITCHES                      (13)
 
 #define MECHANICAL_SWITCHES           ((uint8_t)4)
 #define MECHANICAL_SWITCHES_FIRST_IDX ((uint8_t)0)
@@ -88,7 +93,7 @@
  *   2 logic switches
  *   1 switch always on
  *   1 switch reflecting the flight phase (3-state)
- *   3 switches reflecting a flight phase (2-state
+ *   3 unused switches
  */
 
 #define SWITCH_CONFIGURATION \
@@ -105,10 +110,10 @@ const switchConf_t switchConfiguration[SWITCHES] = { \
     \
     SW_CONF_LOGIC, \
     SW_CONF_PHASES, \
-    SW_CONF_PHASE_N, \
-    SW_CONF_PHASE_N, \
+    SW_CONF_UNUSED, \
+    SW_CONF_UNUSED, \
     \
-    SW_CONF_PHASE_N \
+    SW_CONF_UNUSED \
 };
 
 /* Number of phases.
@@ -121,6 +126,19 @@ const switchConf_t switchConfiguration[SWITCHES] = { \
  */
 #define MIXER                    ((uint8_t)3)
 
+/* Optional modules. TXos.cpp needs them before its includes. */
+#define ENABLE_STATISTICS_MODULE
+#define ENABLE_SERVOTEST_MODULE
+
+/* Compiled mix and output stages as in TXosLocalConfig.h.
+ * To test the run() of the modules instead:
+ *   make clean && make unittest UTDEFS=-DUNITTEST_MODULE_STAGES
+ */
+#ifndef UNITTEST_MODULE_STAGES
+#define ENABLE_MIX_PROGRAM
+#define ENABLE_OUTPUT_PROGRAM
+#endif
+
 /* Port definitions */
 
 /* Analog sticks and other analog channels */
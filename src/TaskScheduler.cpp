@@ -0,0 +1,122 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "TaskScheduler.h"
+
+TaskScheduler::TaskScheduler() {
+
+    taskCount = 0;
+    current = TASK_MAX;
+    start_usec = 0;
+}
+
+void TaskScheduler::addTask( taskFunc_t func, taskPriority_t prio, uint16_t period_msec, uint16_t budget_usec) {
+
+    uint8_t idx;
+
+    if( taskCount >= TASK_MAX) {
+        LOG("** TaskScheduler::addTask(): Too many tasks\n");
+        return;
+    }
+
+    /* Insert behind all tasks of the same or higher priority */
+    idx = taskCount;
+    while( idx > 0 && task[idx -1].prio > prio) {
+        task[idx] = task[idx -1];
+        idx--;
+    }
+
+    task[idx].func = func;
+    task[idx].prio = prio;
+    task[idx].period_msec = period_msec;
+    task[idx].budget_usec = budget_usec;
+    task[idx].nextRun_msec = millis();
+    task[idx].resume = false;
+    task[idx].running = false;
+
+    taskCount++;
+}
+
+bool TaskScheduler::isDue( const task_t &t, unsigned long now) const {
+
+    return !t.running && (t.resume || t.period_msec == 0 || (long)(now - t.nextRun_msec) >= 0);
+}
+
+void TaskScheduler::runTask( uint8_t idx) {
+
+    task_t &t = task[idx];
+    uint8_t outer = current;
+    unsigned long outerStart = start_usec;
+
+    current = idx;
+    start_usec = micros();
+    t.running = true;
+
+    if( t.period_msec > 0 && !t.resume) {
+        t.nextRun_msec = millis() + t.period_msec;
+    }
+
+    t.resume = t.func();
+    t.running = false;
+    current = outer;
+    start_usec = outerStart;
+}
+
+/* Run all due tasks with a priority higher than prio. */
+void TaskScheduler::runHigher( taskPriority_t prio) {
+
+    unsigned long now = millis();
+
+    for( uint8_t idx = 0; idx < taskCount && task[idx].prio < prio; idx++) {
+        if( isDue( task[idx], now)) {
+            runTask( idx);
+        }
+    }
+}
+
+void TaskScheduler::run() {
+
+    unsigned long now;
+
+    for( uint8_t idx = 0; idx < taskCount; idx++) {
+        runHigher( task[idx].prio);
+
+        now = millis();
+        if( isDue( task[idx], now)) {
+            runTask( idx);
+        }
+    }
+}
+
+void TaskScheduler::yield() {
+
+    runHigher( current < taskCount ? task[current].prio : TASK_PRIO_NONE);
+}
+
+bool TaskScheduler::isBudgetExceeded() const {
+
+    return current < taskCount && micros() - start_usec > task[current].budget_usec;
+}
@@ -0,0 +1,115 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/*
+    Cooperative task scheduler for loop().
+
+    Each task is a function that is called when it is due. Tasks run in
+    the order of their priority. Before each task all due tasks with a
+    higher priority are run again, so the channel task is checked between
+    any two lower priority tasks.
+
+    A task that has more work than its time budget allows returns true.
+    It is called again in the next round without waiting for its period.
+    Such a task checks isBudgetExceeded() between chunks of work.
+
+    Long operations that cannot be split call yield(). It runs all due
+    tasks with a higher priority than the running task. A task is never
+    entered again while it is running.
+
+    Priorities:
+      TASK_PRIO_REALTIME   Channel computation and watchdog
+      TASK_PRIO_COMM       Import/export and external display
+      TASK_PRIO_UI         User interface, including EEPROM saves
+      TASK_PRIO_BACKGROUND Statistics
+ */
+
+#ifndef _TaskScheduler_h_
+#define _TaskScheduler_h_
+
+#include "TXos.h"
+
+#define TASK_MAX                 6
+
+typedef uint8_t taskPriority_t;
+
+#define TASK_PRIO_REALTIME       ((taskPriority_t)0)
+#define TASK_PRIO_COMM           ((taskPriority_t)1)
+#define TASK_PRIO_UI             ((taskPriority_t)2)
+#define TASK_PRIO_BACKGROUND     ((taskPriority_t)3)
+#define TASK_PRIO_NONE           ((taskPriority_t)0xff)
+
+/* Returns true if the task has more work and wants to be resumed. */
+typedef bool (*taskFunc_t)();
+
+typedef struct task_t {
+
+    taskFunc_t func;
+    taskPriority_t prio;
+    /* Time between two runs. 0 runs the task in every round. */
+    uint16_t period_msec;
+    /* Time a task should not exceed in one call */
+    uint16_t budget_usec;
+
+    unsigned long nextRun_msec;
+    bool resume;
+    bool running;
+
+} task_t;
+
+class TaskScheduler {
+
+    private:
+        task_t task[TASK_MAX];
+        uint8_t taskCount;
+
+        /* Running task, TASK_MAX if none */
+        uint8_t current;
+        unsigned long start_usec;
+
+        bool isDue( const task_t &t, unsigned long now) const;
+        void runTask( uint8_t idx);
+        void runHigher( taskPriority_t prio);
+
+    public:
+        TaskScheduler();
+
+        /* Tasks are kept sorted by priority. 
+         * Tasks of the same priority run in the order they were added.
+         */
+        void addTask( taskFunc_t func, taskPriority_t prio, uint16_t period_msec, uint16_t budget_usec);
+
+        /* Run one round of all due tasks. Called from loop(). */
+        void run();
+
+        /* Run due tasks of higher priority than the running task. */
+        void yield();
+
+        /* True if the running task has used up its budget. */
+        bool isBudgetExceeded() const;
+};
+
+#endif
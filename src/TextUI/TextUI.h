@@ -105,6 +105,18 @@ enum Mode_t {
 
 typedef uint16_t uiTimer_t;
 
+/* Called between two render chunks, after a row name or a cell.
+ * Returns 'true' to pause rendering. It continues with the next call
+ * of TextUI::handle().
+ */
+typedef bool (*renderHook_t)();
+
+/* Render cursor states.
+ * TEXTUI_RENDER_DONE is a row, TEXTUI_RENDER_ROWNAME a column value.
+ */
+static const uint8_t TEXTUI_RENDER_DONE = 0xff;
+static const uint8_t TEXTUI_RENDER_ROWNAME = 0xfe;
+
 typedef long fixfloat1_t;
 typedef long fixfloat2_t;
 
@@ -1198,6 +1210,14 @@ private:
     Refresh_t refresh;
     Mode_t mode;
 
+    /* Render cursor of a table update in progress.
+     * renderRow is the next table row, TEXTUI_RENDER_DONE if none.
+     * renderCol is the next column or TEXTUI_RENDER_ROWNAME.
+     */
+    uint8_t renderRow = TEXTUI_RENDER_DONE;
+    uint8_t renderCol = TEXTUI_RENDER_ROWNAME;
+    renderHook_t renderHook = nullptr;
+
     void editCurrentCell(TextUILcd *lcd, Event *event);
     void onDemandRefresh(TextUILcd *lcd);
 
@@ -1213,6 +1233,15 @@ private:
      */
     void refreshLine(TextUILcd *lcd, uint8_t row);
 
+    /**
+     * @brief Print the row name and clear the rest of the line.
+     * 
+     * @param lcd  The TextUILcd to print on.
+     * @param row  Table row including back item.
+     * @return uint8_t: Number of cells of this row.
+     */
+    uint8_t refreshRowName(TextUILcd *lcd, uint8_t row);
+
     /**
      * @brief Refresh a single cell.
      * 
@@ -1224,6 +1253,8 @@ private:
 
     void updateScreen(TextUILcd *lcd);
     void updateTable(TextUILcd *lcd);
+    void continueTable(TextUILcd *lcd);
+    uint8_t getLineColCount(uint8_t row);
     void updateRow(TextUILcd *lcd);
     void firstEditableCol(uint8_t row);
     void skipNonEditableCol(uint8_t row);
@@ -1282,6 +1313,20 @@ public:
      */
     boolean inEditMode();
 
+    /**
+     * @brief Check for a paused table update.
+     * 
+     * @return boolean: 'true' if rendering continues with the next call of process().
+     */
+    boolean isRendering() { return renderRow != TEXTUI_RENDER_DONE; }
+
+    /**
+     * @brief Set the hook called between render chunks.
+     * 
+     * @param hook renderHook_t: The hook or nullptr to render in one go.
+     */
+    void setRenderHook(renderHook_t hook) { renderHook = hook; }
+
     /**
      * @brief Force screen refresh.
      */
@@ -1425,6 +1470,24 @@ public:
      */
     Event *getEvent();
 
+    /**
+     * @brief Set the hook called between render chunks.
+     * 
+     * Table updates are drawn in chunks of one row name or one cell.
+     * The hook is called after each chunk. It may run other work and
+     * returns 'true' to pause rendering until the next call of handle().
+     * 
+     * @param hook renderHook_t: The hook or nullptr to render in one go.
+     */
+    void setRenderHook(renderHook_t hook) { handler.setRenderHook( hook); }
+
+    /**
+     * @brief Check for a paused screen update.
+     * 
+     * @return boolean: 'true' if handle() should be called again soon.
+     */
+    boolean isRendering() { return handler.isRendering(); }
+
     /**
      * @brief Main entry point into user interface processing.
      * 
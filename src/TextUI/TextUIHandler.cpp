@@ -45,6 +45,8 @@ void TextUIHandler::clear(TextUI *ui)
     tableCol = 0;
     refresh = REFRESH_FULL;
     mode = MODE_RENDER;
+    renderRow = TEXTUI_RENDER_DONE;
+    renderCol = TEXTUI_RENDER_ROWNAME;
 }
 
 void TextUIHandler::set(TextUI *ui, TextUIScreen *scr)
@@ -103,6 +105,10 @@ void TextUIHandler::process(TextUI *ui, TextUILcd *lcd, Event *event)
 	    UILOG("TextUIHandler::process(): TABLE REFRESH requested by screen\n");
         updateTable(lcd);
     }
+    else if (isRendering())
+    {
+        continueTable(lcd);
+    }
 
     if (event->getType() == EVENT_TYPE_KEY)
     {
@@ -202,6 +208,12 @@ void TextUIHandler::onDemandRefresh(TextUILcd *lcd)
 {
     uint8_t row;
 
+    /* Changed cells are picked up after the table update is complete. */
+    if (isRendering())
+    {
+        return;
+    }
+
     screen->startRefresh();
 
     for (uint8_t tRow = tableTopRow; tRow < tableTopRow + tableVisibleRows; tRow++)
@@ -362,12 +374,11 @@ void TextUIHandler::updateScreen(TextUILcd *lcd)
     updateTable(lcd);
 }
 
+/* Start a table update. It is drawn by continueTable(). */
 void TextUIHandler::updateTable(TextUILcd *lcd)
 {
     UILOG("TextUIHandler::updateTable():\n");
 
-    screen->startRefresh();
-
     useBackItem = screen->goBackItem();
     tableRows = screen->getRowCount() + (useBackItem ? 1 : 0);
     screenHeaderOffs = screen->getHeader() ? 1 : 0;
@@ -383,19 +394,66 @@ void TextUIHandler::updateTable(TextUILcd *lcd)
     UILOGV("TextUIHandler::updateTable(): rows %d topRow %d row%d\n", tableRows, tableTopRow, tableRow);
 
     adjustTopRow(lcd);
-    refresh = REFRESH_ROW;
 
-    for (uint8_t row = tableTopRow; row < tableTopRow + screenTableRows; row++)
+    renderRow = tableTopRow;
+    renderCol = TEXTUI_RENDER_ROWNAME;
+    tableOldRow = tableRow;
+    refresh = REFRESH_OK;
+
+    continueTable(lcd);
+}
+
+/* Draw the table from the render cursor, one row name or cell at a time.
+ * Stop when the render hook asks for a pause.
+ */
+void TextUIHandler::continueTable(TextUILcd *lcd)
+{
+    UILOGV("TextUIHandler::continueTable(): row=%d col=%d\n", renderRow, renderCol);
+
+    screen->startRefresh();
+
+    while (renderRow < tableTopRow + screenTableRows)
     {
-        refreshLine(lcd, row);
+        if (renderCol == TEXTUI_RENDER_ROWNAME)
+        {
+            refreshRowName(lcd, renderRow);
+            renderCol = 0;
+        }
+        else if (renderCol < getLineColCount(renderRow))
+        {
+            refreshCell(lcd, renderRow, renderCol);
+            renderCol++;
+        }
+        else
+        {
+            renderRow++;
+            renderCol = TEXTUI_RENDER_ROWNAME;
+            continue;
+        }
+
+        if (renderHook && renderHook())
+        {
+            screen->endRefresh();
+            return;
+        }
     }
 
-    tableOldRow = tableRow;
-    refresh = REFRESH_OK;
+    renderRow = TEXTUI_RENDER_DONE;
 
     screen->endRefresh();
 }
 
+/* Number of cells of a table row. 0 for the back item and empty lines. */
+uint8_t TextUIHandler::getLineColCount(uint8_t row)
+{
+    if (row >= tableRows || (useBackItem && row == 0))
+    {
+        return 0;
+    }
+
+    return screen->getColCount(useBackItem ? row - 1 : row);
+}
+
 void TextUIHandler::updateRow(TextUILcd *lcd)
 {
     if (adjustTopRow(lcd))
@@ -443,17 +501,29 @@ bool TextUIHandler::adjustTopRow(TextUILcd *lcd)
 
 void TextUIHandler::refreshLine(TextUILcd *lcd, uint8_t row)
 {
-    uint8_t renderRow;
+    uint8_t cols;
     
     UILOGV("TextUIHandler::refreshLine(): row=%d tableRows=%d refr=%d\n", row, tableRows, refresh);
 
+    cols = refreshRowName(lcd, row);
+
+    for (uint8_t col = 0; col < cols; col++)
+    {
+	    refreshCell( lcd, row, col);
+    }
+}
+
+uint8_t TextUIHandler::refreshRowName(TextUILcd *lcd, uint8_t row)
+{
+    uint8_t nameRow;
+
     lcd->setCursor(row - tableTopRow + screenHeaderOffs, 0);
 
     if (row >= tableRows)
     {
         lcd->normalColors();
         lcd->clearEOL();
-        return;
+        return 0;
     }
 
     (tableRow == row) ? lcd->selectedColors() : lcd->normalColors();
@@ -465,26 +535,23 @@ void TextUIHandler::refreshLine(TextUILcd *lcd, uint8_t row)
             lcd->printStr(TEXTUI_TEXT_BACK);
             lcd->normalColors();
             lcd->clearEOL();
-            return;
+            return 0;
         }
         else
         {
-            renderRow = row -1;
+            nameRow = row -1;
         }
     }
     else
     {
-        renderRow = row;
+        nameRow = row;
     }
 
-    lcd->printStr(screen->getRowName(renderRow));
+    lcd->printStr(screen->getRowName(nameRow));
     lcd->normalColors();
     lcd->clearEOL();
 
-    for (uint8_t col = 0; col < screen->getColCount(renderRow); col++)
-    {
-	    refreshCell( lcd, row, col);
-    }
+    return screen->getColCount(nameRow);
 }
 
 void TextUIHandler::refreshCell( TextUILcd *lcd, uint8_t row, uint8_t col)
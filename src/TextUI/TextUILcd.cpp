@@ -26,6 +26,9 @@
 
 #include "TextUI.h"
 #include "TXos.h"
+#include "TaskScheduler.h"
+
+extern TaskScheduler taskScheduler;
 
 void TextUILcd::printInt( int val) {
   
@@ -139,7 +142,7 @@ void TextUILcd::printStr( const char str[], uint8_t width, int8_t editIdx) {
     p++;
   } 
 
-  yieldLoop();
+  taskScheduler.yield();
 }
 
 #ifdef ARDUINO
@@ -170,7 +173,7 @@ void TextUILcd::printStr( const __FlashStringHelper *str, uint8_t width) {
     n++;
   }
 
-  yieldLoop();
+  taskScheduler.yield();
 }
 
 #endif
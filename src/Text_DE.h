@@ -103,6 +103,13 @@
 #define TEXT_OUT_CH_7               CC("S7")
 #define TEXT_OUT_CH_8               CC("S8")
 #define TEXT_OUT_CH_9               CC("S9")
+#define TEXT_OUT_CH_10              CC("S10")
+#define TEXT_OUT_CH_11              CC("S11")
+#define TEXT_OUT_CH_12              CC("S12")
+#define TEXT_OUT_CH_13              CC("S13")
+#define TEXT_OUT_CH_14              CC("S14")
+#define TEXT_OUT_CH_15              CC("S15")
+#define TEXT_OUT_CH_16              CC("S16")
 
 // Switch types (2 letters fixed)
 // Note name length is 3 because the format includes the switch number
@@ -120,7 +127,7 @@
 #define TEXT_SW_TYPE_PHASE_N        CC("PH")
 
 // Logic Switches
-#define TEXT_LOGIC_SW_TYPE_count    ((uint8_t)6)
+#define TEXT_LOGIC_SW_TYPE_count    ((uint8_t)7)
 #define TEXT_LOGIC_SW_TYPE_length   ((uint8_t)7)
 
 #define TEXT_LOGIC_SW_TYPE1         CC("A&B")
@@ -129,10 +136,13 @@
 #define TEXT_LOGIC_SW_TYPE4         CC("A|B|C")
 #define TEXT_LOGIC_SW_TYPE5         CC("(A&B)|C")
 #define TEXT_LOGIC_SW_TYPE6         CC("(A|B)&C")
+#define TEXT_LOGIC_SW_TYPE7         CC("Tabelle")
 
 #define TEXT_LOGIC_SW_A             CC("A")
 #define TEXT_LOGIC_SW_B             CC("B")
 #define TEXT_LOGIC_SW_C             CC("C")
+#define TEXT_LOGIC_SW_D             CC("D")
+#define TEXT_LOGIC_SW_TABLE         CC("Tab")
 
 // Calibration steps (7 letters max)
 #define TEXT_CALIB_length           ((uint8_t)7)
@@ -230,9 +240,13 @@
 #define TEXT_STATISTIC_UI           CC("UI")
 #define TEXT_STATISTIC_MODULE       CC("Modules")
 #define TEXT_STATISTIC_PPMOVER      CC("PPM-Ovr")
-#define TEXT_STATISTIC_FRAMETIME    CC("Frame")
+#define TEXT_STATISTIC_FRAMETIME    CC("Frm-max")
+#define TEXT_STATISTIC_FRAMEMIN     CC("Frm-min")
 #define TEXT_STATISTIC_WDT          CC("WDT")
 #define TEXT_STATISTIC_MEMFREE      CC("MemFree")
+#define TEXT_STATISTIC_MODULES_RUN  CC("Mod-Run")
+#define TEXT_STATISTIC_PROFILE      CC(" min avg  max")
+#define TEXT_STATISTIC_LATENCY      CC("Latenz")
 
 /* User interface warnings and messages */
 #define TEXT_MSG_count              ((uint8_t)6)
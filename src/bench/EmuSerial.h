@@ -0,0 +1,57 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef _EmuSerial_h_
+#define _EmuSerial_h_
+
+#include "stddef.h"
+#include "Stream.h"
+
+/* Headless serial stand-in for the benchmark build.
+ * Everything runs in a single thread, so no locking is needed.
+ * Output is discarded, input is always empty.
+ */
+class EmuSerial : public Stream {
+
+public:
+    EmuSerial();
+
+    /* Interface: Stream */
+
+    void setTimeout(unsigned long timeout) {}; // noop
+
+    size_t write(const char* text);
+
+    void flush() {}; // noop
+
+    int read() { return -1; }
+
+    int available() { return 0; }
+
+    void close() {}; // noop 
+};
+
+#endif
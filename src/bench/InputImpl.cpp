@@ -0,0 +1,142 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "InputImpl.h"
+
+#define ADC_MIN      0
+#define ADC_MAX   1023
+
+/* Frames for one full stick sweep */
+#define SWEEP_FRAMES      200
+/* Frames between switch changes */
+#define SWITCH_FRAMES     300
+
+/* Vcc monitor input. Roughly 10V with default voltage divider. */
+#define AUX_VALUE          650
+
+InputImpl::InputImpl( channel_t stickCnt, channel_t trimCnt, channel_t auxCnt,
+                      uint8_t switches, const switchConf_t *conf)
+{
+    this->stickCount = stickCnt;
+    this->trimCount = trimCnt;
+    this->auxCount = auxCnt;
+    this->channels = stickCnt + trimCnt + auxCnt;
+    this->switches = switches;
+    this->switchConf = conf;
+
+    chValues = new channelValue_t[channels];
+    swValues = new switchState_t[switches];
+
+    benchStep( 0);
+}
+
+void InputImpl::init() {
+
+    /* This is a no-op as all the initialization
+     * has already be done in the constructor.
+     */
+}
+
+uint8_t InputImpl::GetSwitches() {
+
+    return switches;
+}
+
+channelValue_t InputImpl::GetStickValue( int ch) {
+
+    return chValues[ch];
+}
+
+channelValue_t InputImpl::GetTrimValue( int ch) {
+
+    return chValues[ch + stickCount];
+}
+
+channelValue_t InputImpl::GetAuxValue( int ch) {
+
+    return chValues[ch + stickCount + trimCount];
+}
+
+void InputImpl::GetAnalogValues( channelValue_t values[]) {
+
+    memcpy( values, chValues, channels * sizeof(channelValue_t));
+}
+
+/* Values are read on request */
+unsigned long InputImpl::GetAnalogTime() {
+
+    return micros();
+}
+
+switchState_t InputImpl::GetSwitchValue( int sw) {
+
+    return swValues[sw];
+}
+
+switchConf_t InputImpl::GetSwitchConf( int sw) {
+
+    return switchConf[sw];
+}
+
+switchBits_t InputImpl::GetSwitchStates() {
+
+    switchBits_t states = 0;
+
+    for( switch_t sw = 0; sw < switches && sw < SWITCHES; sw++) {
+        states |= (switchBits_t)(GetSwitchValue( sw) & 0x03) << SWITCH_BITS_POS( sw);
+    }
+
+    return states;
+}
+
+void InputImpl::benchStep( uint32_t frame) {
+
+    uint32_t pos;
+
+    /* Triangle wave per channel. Each channel has its own speed
+     * so that the channels do not move in sync.
+     */
+    for( channel_t ch = 0; ch < stickCount + trimCount; ch++) {
+        pos = (frame * (ch + 1) * (ADC_MAX - ADC_MIN) / SWEEP_FRAMES) % (2 * (ADC_MAX - ADC_MIN));
+        if( pos > (ADC_MAX - ADC_MIN)) {
+            pos = 2 * (ADC_MAX - ADC_MIN) - pos;
+        }
+        chValues[ch] = (channelValue_t)(ADC_MIN + pos);
+    }
+
+    for( channel_t ch = stickCount + trimCount; ch < channels; ch++) {
+        chValues[ch] = AUX_VALUE;
+    }
+
+    for( uint8_t sw = 0; sw < switches; sw++) {
+        pos = (frame / SWITCH_FRAMES) + sw;
+        if( switchConf[sw] == SW_CONF_3STATE) {
+            swValues[sw] = (switchState_t)(pos % 3);
+        } else {
+            swValues[sw] = (switchState_t)(pos % 2);
+        }
+    }
+}
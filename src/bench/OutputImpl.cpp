@@ -0,0 +1,64 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "OutputImpl.h"
+
+OutputImpl::OutputImpl( int channels)
+{
+}
+
+bool OutputImpl::acceptChannels() {
+
+    return true;
+}
+
+void OutputImpl::SetChannelValue(int channel, int value) {
+
+    /* FNV-1a style mix of channel number and value */
+    checksum = (checksum ^ (uint32_t)((channel << 16) ^ (value & 0xffff))) * 16777619UL;
+}
+
+void OutputImpl::SetChannelValues( const channelValue_t values[]) {
+
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        SetChannelValue( ch, values[ch]);
+    }
+}
+
+uint16_t OutputImpl::getOverrunCounter() {
+
+    return 0;
+}
+
+timingUsec_t OutputImpl::getMaxFrameTime() {
+
+    return 0;
+}
+
+timingUsec_t OutputImpl::getMinFrameTime() {
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef _OutputImpl_h_
+#define _OutputImpl_h_
+
+#include "Controls.h"
+
+/* Output for the benchmark build.
+ * Always accepts new channel values and keeps a checksum
+ * of all values set. The checksum allows to verify that an
+ * optimization does not change the output.
+ */
+class OutputImpl {
+
+        uint32_t checksum = 0;
+        
+    public:
+        explicit OutputImpl( int channels);
+
+        bool acceptChannels();
+        void SetChannelValue( int channel, int value);
+        void SetChannelValues( const channelValue_t values[]);
+        void SetInputTime( unsigned long t) { }
+        bool getLatency( uint32_t &usec) { return false; }
+        uint16_t getOverrunCounter();
+        timingUsec_t getMaxFrameTime();
+        timingUsec_t getMinFrameTime();
+
+        uint32_t getChecksum() const { return checksum; }
+        void resetChecksum() { checksum = 0; }
+};
+
+#endif
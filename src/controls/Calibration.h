@@ -0,0 +1,88 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef _Calibration_h_
+#define _Calibration_h_
+
+#include "Controls.h"
+
+/* Largest ADC offset from the calibrated mid position and largest
+ * calibrated half range the fast path handles. 10 bit ADC.
+ */
+#define CALIBRATION_MAX_DELTA   1023L
+
+/* Fixed-point reciprocal for one half axis of a calibrated input.
+ *
+ * Maps an ADC offset d from the mid position to d * range / span
+ * with a multiply and a shift instead of a 32 bit division.
+ * The result is exact (same as the integer division) as long as
+ * d and span are within CALIBRATION_MAX_DELTA.
+ * A factor of 0 means the span is out of range for the fast path.
+ */
+typedef struct calibrationScale_t {
+
+    uint32_t factor;
+    uint8_t shift;
+
+} calibrationScale_t;
+
+/* Compute the scale for range / span.
+ * Called whenever the calibration data changes.
+ */
+static inline void calibrationScaleSet( calibrationScale_t &scale, long range, long span) {
+
+    uint8_t shift = 0;
+
+    if( span <= 0 || span > CALIBRATION_MAX_DELTA) {
+        scale.factor = 0;
+        scale.shift = 0;
+        return;
+    }
+
+    /* 2^shift > CALIBRATION_MAX_DELTA * span makes the rounding error
+     * of the reciprocal too small to change the truncated result.
+     */
+    while( (1UL << shift) <= (unsigned long)(CALIBRATION_MAX_DELTA * span)) {
+        shift++;
+    }
+
+    scale.factor = (((uint32_t)range << shift) + (uint32_t)span - 1) / (uint32_t)span;
+    scale.shift = shift;
+}
+
+/* Return d * range / span for d >= 0.
+ * Falls back to the division if d or span is out of range.
+ */
+static inline long calibrationScale( const calibrationScale_t &scale, long d, long range, long span) {
+
+    if( scale.factor != 0 && d <= CALIBRATION_MAX_DELTA) {
+        return (long)(((uint32_t)d * scale.factor) >> scale.shift);
+    }
+
+    return (d * range) / span;
+}
+
+#endif
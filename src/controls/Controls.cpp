@@ -37,14 +37,10 @@ Controls::Controls() = default;
 
 void Controls::init() {
 
-    //inputImpl->init();
-}
-
-void Controls::GetControlValues() {
-
     channel_t ch;
 
-    /* Clean values */
+    //inputImpl->init();
+
     for( ch = 0; ch < INPUT_CHANNELS; ch++) {
         controlSet.inputChannel[ch] = CHANNELVALUE_MID;
     }
@@ -57,48 +53,78 @@ void Controls::GetControlValues() {
         controlSet.outChannel[ch] = CHANNELVALUE_MID;
     }
 
-    /* Read analog inputs */
-    for( ch = 0; ch < PORT_ANALOG_INPUT_COUNT; ch++) {
-        controlSet.stickADCChannel[ch] = inputImpl->GetStickValue( ch);
-    }
+    /* Switch configuration and type table */
+    fixedStates = 0;
 
-    for( ch = 0; ch < PORT_TRIM_INPUT_COUNT; ch++) {
-        controlSet.trimADCChannel[ch] = inputImpl->GetTrimValue( ch);
+    for( switch_t sw = 0; sw < SWITCHES; sw++) {
+        switchConf[sw] = inputImpl->GetSwitchConf( sw);
+        if( switchConf[sw] == SW_CONF_FIXED_ON) {
+            fixedStates |= (switchBits_t)SW_STATE_1 << SWITCH_BITS_POS( sw);
+        }
     }
 
-    for( ch = 0; ch < PORT_AUX_INPUT_COUNT; ch++) {
-        controlSet.auxADCChannel[ch] = inputImpl->GetAuxValue( ch);
-    }
+    uint8_t n = 0;
 
-    /* Read switch inputs */
-    for( switch_t sw = 0; sw < SWITCHES; sw++) {
-        switchState_t state;
-
-        if( sw < inputImpl->GetSwitches()) {
-            state = inputImpl->GetSwitchValue( sw);
-        } else if (switchConfGet(sw) == SW_CONF_FIXED_ON) {
-            state = SW_STATE_1;
-        } else {
-            state = SW_STATE_0;
+    for( uint8_t type = 0; type < SW_CONF_COUNT; type++) {
+        switchTypeFirst[type] = n;
+        for( switch_t sw = 0; sw < SWITCHES; sw++) {
+            if( switchConf[sw] == type) {
+                switchByType[n++] = sw;
+            }
         }
+    }
+
+    switchTypeFirst[SW_CONF_COUNT] = n;
+
+    controlSet.switchStates = fixedStates;
+}
+
+void Controls::GetControlValues() {
+
+    channel_t ch;
+
+    /* Clean values.
+     * Only channels that are not written by the pipeline on every frame
+     * need to be reset:
+     * - Stick inputs are written by CalibrateSticks.
+     * - Switched channels are only written if their switch is used.
+     * - The first MIX_CHANNELS logical channels are written by AssignInput.
+     *   The mix counterparts (AIL2, FLP2, SPL2) are not written for all wing mixes.
+     * - All output channels are written by ServoRemap.
+     */
+    for( ch = PORT_ANALOG_INPUT_COUNT; ch < INPUT_CHANNELS; ch++) {
+        controlSet.inputChannel[ch] = CHANNELVALUE_MID;
+    }
 
-        switchSet( sw, state);
+    for( ch = MIX_CHANNELS; ch < LOGICAL_CHANNELS; ch++) {
+        controlSet.logicalChannel[ch] = CHANNELVALUE_MID;
     }
+
+    /* Read analog inputs. One snapshot of all ADC channels. */
+    inputImpl->GetAnalogValues( controlSet.adcChannel);
+#ifdef ENABLE_LATENCY_STATISTICS
+    controlSet.inputTime_usec = inputImpl->GetAnalogTime();
+#endif
+
+    /* Read switch inputs.
+     * Switches without input are SW_STATE_0 or SW_STATE_1 for SW_CONF_FIXED_ON.
+     */
+    controlSet.switchStates = fixedStates | inputImpl->GetSwitchStates();
 }
 
 channelValue_t Controls::stickADCGet( channel_t ch) {
 
-    return controlSet.stickADCChannel[ch];
+    return controlSet.adcChannel[ch];
 }
 
 channelValue_t Controls::trimADCGet( channel_t ch) {
 
-    return controlSet.trimADCChannel[ch];
+    return controlSet.adcChannel[PORT_ANALOG_INPUT_COUNT + ch];
 }
 
 channelValue_t Controls::auxADCGet( channel_t ch) {
 
-    return controlSet.auxADCChannel[ch];
+    return controlSet.adcChannel[PORT_ANALOG_INPUT_COUNT + PORT_TRIM_INPUT_COUNT + ch];
 }
 
 void Controls::inputSet( channel_t ch, channelValue_t value) {
@@ -219,7 +245,8 @@ void Controls::switchSet( switch_t sw, switchState_t value) {
     // LOGV("Controls::switchSet(): sw=%d state=%d\n", swn, value);
 
     if( swn < SWITCHES) {
-        SET_SWITCH_STATE( controlSet.switches[swn], value);
+        controlSet.switchStates = (controlSet.switchStates & ~SWITCH_BITS_MASK( swn))
+                                | ((switchBits_t)(value & 0x03) << SWITCH_BITS_POS( swn));
     }
 }
 
@@ -229,7 +256,7 @@ switchState_t Controls::switchGet( switch_t sw) {
     switchState_t state;
 
     if( swn < SWITCHES) {
-        state = GET_SWITCH_STATE( controlSet.switches[swn]);
+        state = (switchState_t)((controlSet.switchStates >> SWITCH_BITS_POS( swn)) & 0x03);
     } else {
         state = SW_STATE_DONTCARE;
     }
@@ -243,7 +270,7 @@ switchConf_t Controls::switchConfGet( switch_t sw) {
 
     uint8_t swn = GET_SWITCH( sw);
 
-    return inputImpl->GetSwitchConf( swn);
+    return (swn < SWITCHES) ? switchConf[swn] : SW_CONF_UNUSED;
 }
 
 switch_t Controls::getSwitchByType( switchConf_t type, uint8_t idx) {
@@ -252,16 +279,9 @@ switch_t Controls::getSwitchByType( switchConf_t type, uint8_t idx) {
     
     // Set switch to unused
     INIT_SWITCH( sw);
-    
-    for( switch_t i = 0; i < SWITCHES; i++) {
-        if(  switchConfGet(i) == type) {
-            if(idx == 0) {
-                sw = i;
-                break;
-            } else {
-                idx--;
-            }
-        }
+
+    if( type < SW_CONF_COUNT && idx < switchTypeFirst[type +1] - switchTypeFirst[type]) {
+        sw = switchByType[ switchTypeFirst[type] + idx];
     }
 
     return sw;
@@ -355,6 +375,38 @@ void Controls::copySwitchNameAndState( char *b, switch_t sw) {
 
 bool Controls::evalSwitches( switch_t trigger) {
 
-    return IS_SWITCH_USED( trigger) 
-            && GET_SWITCH_STATE( trigger) == GET_SWITCH_STATE( controlSet.switches[ GET_SWITCH(trigger)]);
+    uint8_t swn = GET_SWITCH( trigger);
+
+    return IS_SWITCH_USED( trigger) && swn < SWITCHES
+            && GET_SWITCH_STATE( trigger) == (switchState_t)((controlSet.switchStates >> SWITCH_BITS_POS( swn)) & 0x03);
+}
+
+void Controls::conditionInit( switchCondition_t &cond) {
+
+    cond.mask = 0;
+    cond.value = 0;
+}
+
+void Controls::conditionAdd( switchCondition_t &cond, switch_t trigger) {
+
+    uint8_t swn = GET_SWITCH( trigger);
+    switchBits_t mask;
+    switchBits_t value;
+
+    if( IS_SWITCH_UNUSED( trigger) || swn >= SWITCHES || GET_SWITCH_STATE( trigger) > SW_STATE_DONTCARE) {
+        cond.value |= SWITCH_CONDITION_NEVER;
+        return;
+    }
+
+    mask = SWITCH_BITS_MASK( swn);
+    value = (switchBits_t)GET_SWITCH_STATE( trigger) << SWITCH_BITS_POS( swn);
+
+    /* Two different states of the same switch can never be met at once. */
+    if( (cond.mask & mask) && (cond.value & mask) != value) {
+        cond.value |= SWITCH_CONDITION_NEVER;
+        return;
+    }
+
+    cond.mask |= mask;
+    cond.value |= value;
 }
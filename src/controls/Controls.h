@@ -50,6 +50,9 @@ typedef uint16_t timingUsec_t;
 
 #define CHANNELVALUE_MID        ((channelValue_t)    0)
 
+/* Number of raw ADC inputs. Sticks, trims and aux inputs. */
+#define ADC_INPUT_CHANNELS      (PORT_ANALOG_INPUT_COUNT + PORT_TRIM_INPUT_COUNT + PORT_AUX_INPUT_COUNT)
+
 #define CHANNELVALUE_MIN        ((channelValue_t)-1000)
 #define CHANNELVALUE_MAX        ((channelValue_t) 1000)
 
@@ -125,17 +128,45 @@ typedef uint8_t switch_t;
 #define SET_SWITCH_STATE( sw, state)    sw = (((sw) & ~SWITCH_STATE_MASK) | (((state) << 4) & SWITCH_STATE_MASK))
 #define GET_SWITCH_STATE( sw)           ((switchState_t)(((sw) & SWITCH_STATE_MASK) >> 4))
 
+/* Packed states of all switches.
+ * 2 bits per switch, switch 0 in bits 0 and 1.
+ * The highest bit is never used by a switch. See SWITCH_CONDITION_NEVER.
+ */
+#if SWITCHES < 16
+typedef uint32_t switchBits_t;
+#else
+typedef uint64_t switchBits_t;
+#endif
+
+#define SWITCH_BITS_POS( swn)           ((uint8_t)((swn) << 1))
+#define SWITCH_BITS_MASK( swn)          ((switchBits_t)0x03 << SWITCH_BITS_POS( swn))
+#define SWITCH_CONDITION_NEVER          ((switchBits_t)1 << (sizeof(switchBits_t) * 8 -1))
+
+/* A set of switch triggers that must all be met.
+ * Evaluated with one mask and compare:
+ *
+ *   (switch states & mask) == value
+ *
+ * An empty set is always true. A set that contains an unused
+ * trigger is never true.
+ */
+typedef struct switchCondition_t {
+
+    switchBits_t mask;
+    switchBits_t value;
+
+} switchCondition_t;
+
 
 /* State of all controls.
  * Controls are sticks, switches and logical switches.
  */
 typedef struct controlSet_t {
     
-    /* Raw analog input channels */
-    channelValue_t stickADCChannel[ PORT_ANALOG_INPUT_COUNT ];
-
-    channelValue_t trimADCChannel[ PORT_TRIM_INPUT_COUNT ];
-    channelValue_t auxADCChannel[ PORT_AUX_INPUT_COUNT ];
+    /* Raw analog input channels.
+     * Sticks, trims and aux inputs in this order.
+     */
+    channelValue_t adcChannel[ ADC_INPUT_CHANNELS ];
 
     /* Calibrated analog input channels */
     channelValue_t inputChannel[ INPUT_CHANNELS ];
@@ -147,7 +178,12 @@ typedef struct controlSet_t {
     /* Calibrated and mixed analog channels */
     channelValue_t outChannel[ PPM_CHANNELS ];
 
-    switch_t switches[SWITCHES];
+    switchBits_t switchStates;
+
+#ifdef ENABLE_LATENCY_STATISTICS
+    /* micros() of the ADC snapshot in adcChannel */
+    unsigned long inputTime_usec;
+#endif
 
 } controlSet_t;
 
@@ -156,6 +192,19 @@ class Controls {
     private:
         controlSet_t controlSet;
 
+        /* Switch configuration, built once in init() */
+        switchConf_t switchConf[SWITCHES];
+
+        /* States of switches that are not read from input (SW_CONF_FIXED_ON) */
+        switchBits_t fixedStates;
+
+        /* Switch numbers sorted by switch type.
+         * The switches of type t are switchByType[ switchTypeFirst[t] ]
+         * up to switchByType[ switchTypeFirst[t+1] -1 ]
+         */
+        switch_t switchByType[SWITCHES];
+        uint8_t switchTypeFirst[SW_CONF_COUNT +1];
+
     public:
         Controls();
 
@@ -166,6 +215,11 @@ class Controls {
          */
         void GetControlValues();
 
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* Time of the ADC snapshot of the current control set */
+        unsigned long getInputTime() const { return controlSet.inputTime_usec; }
+#endif
+
         channelValue_t stickADCGet( channel_t ch);
         channelValue_t trimADCGet( channel_t ch);
         channelValue_t auxADCGet( channel_t ch);
@@ -179,6 +233,9 @@ class Controls {
         void trimSet( channel_t ch, channelValue_t value);
         channelValue_t trimGet( channel_t ch);
 
+        /* Values are limited to CHANNELVALUE_MIN_LIMIT/CHANNELVALUE_MAX_LIMIT here.
+         * Modules do not need to limit logical channels on their own.
+         */
         void logicalSet( channel_t ch, channelValue_t value);
         channelValue_t logicalGet( channel_t ch);
 
@@ -199,6 +256,47 @@ class Controls {
         void copySwitchNameAndState( char *b, switch_t sw);
 
         bool evalSwitches( switch_t trigger);
+
+        /* Reset cond to an empty set of triggers. */
+        static void conditionInit( switchCondition_t &cond);
+
+        /* Add a trigger to cond. */
+        static void conditionAdd( switchCondition_t &cond, switch_t trigger);
+
+        /* True if all triggers of cond are met. */
+        bool evalCondition( const switchCondition_t &cond) const {
+            return (controlSet.switchStates & cond.mask) == cond.value;
+        }
+
+        /* Fast path for the modules of the channel pipeline.
+         *
+         * Direct access to the channel arrays of the input, logical and
+         * output stage. Channel numbers are not checked and written values
+         * are not limited. Modules must only use valid channel numbers and
+         * apply limit() wherever the next module of the same stage
+         * depends on a limited value.
+         * Output channels are limited once at the end of the output stage 
+         * by ServoLimit.
+         *
+         * UI code uses the checked accessors above.
+         */
+        channelValue_t *inputChannels() { return controlSet.inputChannel; }
+        channelValue_t *logicalChannels() { return controlSet.logicalChannel; }
+        channelValue_t *outputChannels() { return controlSet.outChannel; }
+        const channelValue_t *trimChannels() const { return controlSet.trimChannel; }
+
+        static inline channelValue_t limit( channelValue_t v) {
+
+            if( v > CHANNELVALUE_MAX_LIMIT) {
+                return CHANNELVALUE_MAX_LIMIT;
+            }
+
+            if( v < CHANNELVALUE_MIN_LIMIT) {
+                return CHANNELVALUE_MIN_LIMIT;
+            }
+
+            return v;
+        }
 };
 
 #endif
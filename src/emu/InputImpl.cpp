@@ -182,6 +182,17 @@ channelValue_t InputImpl::GetAuxValue( int ch) {
     return chValues[ch + stickCount + trimCount];
 }
 
+void InputImpl::GetAnalogValues( channelValue_t values[]) {
+
+    memcpy( values, chValues, channels * sizeof(channelValue_t));
+}
+
+/* Values are read on request */
+unsigned long InputImpl::GetAnalogTime() {
+
+    return micros();
+}
+
 switchState_t InputImpl::GetSwitchValue( int sw) {
 
     return swValues[sw];
@@ -192,6 +203,17 @@ switchConf_t InputImpl::GetSwitchConf( int sw) {
     return switchConf[sw];
 }
 
+switchBits_t InputImpl::GetSwitchStates() {
+
+    switchBits_t states = 0;
+
+    for( switch_t sw = 0; sw < switches && sw < SWITCHES; sw++) {
+        states |= (switchBits_t)(GetSwitchValue( sw) & 0x03) << SWITCH_BITS_POS( sw);
+    }
+
+    return states;
+}
+
 void InputImpl::OnScroll( wxScrollEvent& event) {
 
     for( int i=0; i<channels; i++) {
@@ -67,6 +67,13 @@ class InputImpl : public wxBoxSizer
         channelValue_t GetStickValue( int ch);
         channelValue_t GetTrimValue( int ch);
         channelValue_t GetAuxValue( int ch);
+
+        /* Copy all analog values (sticks, trims and aux inputs) at once. */
+        void GetAnalogValues( channelValue_t values[]);
+        unsigned long GetAnalogTime();
+
+        /* States of all switches. 2 bits per switch, see SWITCH_BITS_POS() */
+        switchBits_t GetSwitchStates();
         switchState_t GetSwitchValue( int sw);
         switchConf_t GetSwitchConf( int sw);
 
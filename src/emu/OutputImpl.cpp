@@ -58,7 +58,7 @@ bool OutputImpl::acceptChannels() {
 
     long now = millis();
 
-    if( now >= lastFrameMs + PPM_FRAME_TIME_usec/1000 ) {
+    if( now >= lastFrameMs + OUTPUT_FRAME_TIME_usec/1000 ) {
         lastFrameMs = now;
         return true;
     } 
@@ -74,6 +74,13 @@ void OutputImpl::SetChannelValue(int channel, int value) {
     gauges[channel]->SetValue( value+1500);
 }
 
+void OutputImpl::SetChannelValues( const channelValue_t values[]) {
+
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        SetChannelValue( ch, values[ch]);
+    }
+}
+
 uint16_t OutputImpl::getOverrunCounter() {
 
     return 0;
@@ -84,6 +91,11 @@ timingUsec_t OutputImpl::getMaxFrameTime() {
     return 0;
 }
 
+timingUsec_t OutputImpl::getMinFrameTime() {
+
+    return 0;
+}
+
 OutputImpl::~OutputImpl( void) {
 
     if( channelIDs != NULL) {
@@ -50,8 +50,12 @@ class OutputImpl : public wxStaticBoxSizer
 
         bool acceptChannels();
         void SetChannelValue( int channel, int value);
+        void SetChannelValues( const channelValue_t values[]);
+        void SetInputTime( unsigned long t) { }
+        bool getLatency( uint32_t &usec) { return false; }
         uint16_t getOverrunCounter();
         timingUsec_t getMaxFrameTime();
+        timingUsec_t getMinFrameTime();
 };
 
 #endif
@@ -28,6 +28,7 @@
 #define __Stream_h__
 
 #include "stddef.h"
+#include "stdint.h"
 
 /* A stream class to make Arduino code work in Designer.
  * This is used by Lights/Comm class.
@@ -42,6 +43,7 @@ class Stream {
         virtual void setTimeout(unsigned long timeout) = 0;
 
         virtual size_t write( const char* text) = 0;
+        virtual size_t write( const uint8_t *buffer, size_t size) { return 0; }
         virtual void flush() = 0;
 
         virtual int read() = 0;
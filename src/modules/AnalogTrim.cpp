@@ -101,18 +101,21 @@ void AnalogTrim::run(Controls& controls) {
         break;
     }
 
+    channelValue_t* logical = controls.logicalChannels();
+    const channelValue_t* trim = controls.trimChannels();
+
     for (channel_t ch = 0; ch < MIX_CHANNELS; ch++) {
         channel_t in = assignInput->getInputChannel(ch);
 
         if (in < PORT_TRIM_INPUT_COUNT) {
-            v = controls.logicalGet(ch) + controls.trimGet(in) + PCT_TO_CHANNEL(CFG->storedTrim_pct[in]);
+            v = logical[ch] + trim[in] + PCT_TO_CHANNEL(CFG->storedTrim_pct[in]);
             if (v < CHANNELVALUE_MIN_LIMIT) {
                 v = CHANNELVALUE_MIN_LIMIT;
             }
             else if (v > CHANNELVALUE_MAX_LIMIT) {
                 v = CHANNELVALUE_MAX_LIMIT;
             }
-            controls.logicalSet(ch, v);
+            logical[ch] = v;
         }
     }
 }
@@ -63,8 +63,13 @@ COMM_RC_t AssignInput::importConfig( ImportExport *importer, uint8_t *config) co
 
 void AssignInput::run( Controls &controls) {
 
+    const channelValue_t *input = controls.inputChannels();
+    channelValue_t *logical = controls.logicalChannels();
+    channel_t source;
+
     for( channel_t ch = 0; ch < MIX_CHANNELS; ch++) {
-        controls.logicalSet( ch, controls.inputGet( CFG->source[ch]));
+        source = CFG->source[ch];
+        logical[ch] = (source < INPUT_CHANNELS) ? input[source] : CHANNELVALUE_MID;
     }
 }
 
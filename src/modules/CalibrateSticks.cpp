@@ -62,6 +62,7 @@ void CalibrateSticks::run( Controls &controls) {
         if( calibrationStep == CALIBRATION_STEP_CENTER) {
 
             CFG->midPos[ch] = CFG->maxPos[ch] = CFG->minPos[ch] = (channelValue_t)v;
+            controls.inputSet( ch, CHANNELVALUE_MID);
 
         } else if( calibrationStep == CALIBRATION_STEP_MINMAX) {
 
@@ -70,13 +71,16 @@ void CalibrateSticks::run( Controls &controls) {
             } else if( v > CFG->maxPos[ch]) {
                 CFG->maxPos[ch] = (channelValue_t)v;
             }
+            controls.inputSet( ch, CHANNELVALUE_MID);
 
         } else {
 
             if( v > CFG->midPos[ch]) {
-                v = ((v - CFG->midPos[ch]) * (CHANNELVALUE_MAX_LIMIT - CHANNELVALUE_MID)) / (CFG->maxPos[ch] - CFG->midPos[ch]);
+                v = calibrationScale( posScale[ch], v - CFG->midPos[ch],
+                                      CHANNELVALUE_MAX_LIMIT - CHANNELVALUE_MID, CFG->maxPos[ch] - CFG->midPos[ch]);
             } else if( v < CFG->midPos[ch]) {
-                v = ((v - CFG->midPos[ch]) * (CHANNELVALUE_MID - CHANNELVALUE_MIN_LIMIT)) / (CFG->midPos[ch] - CFG->minPos[ch]);
+                v = -calibrationScale( negScale[ch], CFG->midPos[ch] - v,
+                                       CHANNELVALUE_MID - CHANNELVALUE_MIN_LIMIT, CFG->midPos[ch] - CFG->minPos[ch]);
             } else {
                 v = CHANNELVALUE_MID;
             }
@@ -86,6 +90,19 @@ void CalibrateSticks::run( Controls &controls) {
     }
 }
 
+void CalibrateSticks::init() {
+
+    updateScale();
+}
+
+void CalibrateSticks::updateScale() {
+
+    for( channel_t ch = 0; ch < PORT_ANALOG_INPUT_COUNT; ch++) {
+        calibrationScaleSet( posScale[ch], CHANNELVALUE_MAX_LIMIT - CHANNELVALUE_MID, CFG->maxPos[ch] - CFG->midPos[ch]);
+        calibrationScaleSet( negScale[ch], CHANNELVALUE_MID - CHANNELVALUE_MIN_LIMIT, CFG->midPos[ch] - CFG->minPos[ch]);
+    }
+}
+
 void CalibrateSticks::setDefaults() {
 
     INIT_NON_PHASED_CONFIGURATION(
@@ -98,6 +115,7 @@ void CalibrateSticks::setDefaults() {
     )
 
     calibrationStep = CALIBRATION_STEP_NONE;
+    updateScale();
 }
 
 /* From TextUIScreen */
@@ -123,6 +141,7 @@ void CalibrateSticks::rowExecute( TextUI *ui, uint8_t row ) {
 
     default:
         calibrationStep = CALIBRATION_STEP_NONE;
+        updateScale();
         break;
     }
 }
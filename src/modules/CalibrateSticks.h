@@ -28,6 +28,7 @@
 #define _CalibrateSticks_h_
 
 #include "Module.h"
+#include "Calibration.h"
 
 /* Calibrate analog inputs.
  * 
@@ -56,11 +57,20 @@ class CalibrateSticks : public Module {
 #define CALIBRATION_STEP_CENTER   1
 #define CALIBRATION_STEP_MINMAX   2
 
+        /* Scale factors for the upper and lower half of each axis.
+         * Recomputed whenever min, mid or max positions change.
+         */
+        calibrationScale_t posScale[PORT_ANALOG_INPUT_COUNT];
+        calibrationScale_t negScale[PORT_ANALOG_INPUT_COUNT];
+
+        void updateScale();
+
     public:
         CalibrateSticks();
 
         /* From Module */
         void run( Controls &controls) final;
+        void init() final;
         void setDefaults() final;
         COMM_RC_t exportConfig( ImportExport *exporter, uint8_t *config) const;
         COMM_RC_t importConfig( ImportExport *importer, uint8_t *config) const;
@@ -75,9 +75,11 @@ void CalibrateTrim::run( Controls &controls) {
         } else {
 
             if( v > CFG->midPos[ch]) {
-                v = ((v - CFG->midPos[ch]) * (TRIMVALUE_MAX_LIMIT - TRIMVALUE_MID)) / (CFG->maxPos[ch] - CFG->midPos[ch]);
+                v = calibrationScale( posScale[ch], v - CFG->midPos[ch],
+                                      TRIMVALUE_MAX_LIMIT - TRIMVALUE_MID, CFG->maxPos[ch] - CFG->midPos[ch]);
             } else if( v < CFG->midPos[ch]) {
-                v = ((v - CFG->midPos[ch]) * (TRIMVALUE_MID - TRIMVALUE_MIN_LIMIT)) / (CFG->midPos[ch] - CFG->minPos[ch]);
+                v = -calibrationScale( negScale[ch], CFG->midPos[ch] - v,
+                                       TRIMVALUE_MID - TRIMVALUE_MIN_LIMIT, CFG->midPos[ch] - CFG->minPos[ch]);
             } else {
                 v = TRIMVALUE_MID;
             }
@@ -87,6 +89,19 @@ void CalibrateTrim::run( Controls &controls) {
     }
 }
 
+void CalibrateTrim::init() {
+
+    updateScale();
+}
+
+void CalibrateTrim::updateScale() {
+
+    for( channel_t ch = 0; ch < PORT_TRIM_INPUT_COUNT; ch++) {
+        calibrationScaleSet( posScale[ch], TRIMVALUE_MAX_LIMIT - TRIMVALUE_MID, CFG->maxPos[ch] - CFG->midPos[ch]);
+        calibrationScaleSet( negScale[ch], TRIMVALUE_MID - TRIMVALUE_MIN_LIMIT, CFG->midPos[ch] - CFG->minPos[ch]);
+    }
+}
+
 void CalibrateTrim::setDefaults() {
 
     INIT_NON_PHASED_CONFIGURATION(
@@ -99,6 +114,7 @@ void CalibrateTrim::setDefaults() {
     )
 
     calibrationStep = CALIBRATION_STEP_NONE;
+    updateScale();
 }
 
 /* From TextUIScreen */
@@ -124,6 +140,7 @@ void CalibrateTrim::rowExecute( TextUI *ui, uint8_t row ) {
 
     default:
         calibrationStep = CALIBRATION_STEP_NONE;
+        updateScale();
         break;
     }
 }
@@ -52,45 +52,100 @@ COMM_RC_t ChannelDelay::importConfig( ImportExport *importer, uint8_t *config) c
     return importer->runImport( DICT_ptr(ChannelDelay), DICTROW_ptr(ChannelDelay), config, sizeof(channelDelay_t));
 }
 
+/* 1.0 in fixed point position units */
+#define DELAY_SCALE   ((int32_t)1 << CHANNELDELAY_FRACTION_BITS)
+
+/* Full travel per frame multiplied with the delay in msec */
+#define DELAY_TRAVEL_MSEC   ((int32_t)(CHANNELVALUE_MAX - CHANNELVALUE_MIN) * OUTPUT_FRAME_TIME_usec / 1000 * DELAY_SCALE)
+
+/* Elapsed time is scaled to 1/1024 of OUTPUT_FRAME_TIME_usec */
+#define FRAME_SCALE_BITS    10
+
+/* Limit the step after a stall, e.g. while saving to EEPROM */
+#define FRAME_ELAPSED_MAX_usec  ((uint32_t)OUTPUT_FRAME_TIME_usec * 4)
+
 void ChannelDelay::run( Controls &controls) {
 
-#define SCALING_F (10)
+    int32_t targetPosition;
+    channelValue_t *logical = controls.logicalChannels();
+    unsigned long now = micros();
+    uint32_t elapsed_usec = now - lastRun_usec;
+
+    lastRun_usec = now;
+
+    /* Start from the current position after being inactive. */
+    if( resync) {
+        for( uint8_t mix = 0; mix < MIX_CHANNELS; mix++) {
+            lastPosition[mix] = logical[mix] * DELAY_SCALE;
+        }
+        resync = false;
+    }
+
+    if( elapsed_usec > FRAME_ELAPSED_MAX_usec) {
+        elapsed_usec = FRAME_ELAPSED_MAX_usec;
+    }
 
-    int16_t targetPosition10;  // scaled by 10 for increased precision
-    int16_t stepPosition10;    // same here
-    int16_t delay_msec;
+    int32_t frameScale = (int32_t)((elapsed_usec << FRAME_SCALE_BITS) / OUTPUT_FRAME_TIME_usec);
 
     for( uint8_t mix = 0; mix < MIX_CHANNELS; mix++) {
 
-        /* The target position in 1/10 % scaled to 1/100 % */
-        targetPosition10 = controls.logicalGet( mix) * SCALING_F;
+        targetPosition = logical[mix] * DELAY_SCALE;
 
-        if( (CFG->posDelay_sec[mix] > 0) && (targetPosition10 > lastChannelValue10[mix]) ) {
-            // posDelay_sec is a scaled float in 1/10 sec resolution. Convert to msec.
-            delay_msec = CFG->posDelay_sec[mix] * 100;
-            stepPosition10 = (int16_t)((int32_t)((CHANNELVALUE_MAX - CHANNELVALUE_MIN) * SCALING_F) * PPM_FRAME_TIME_usec / 1000 / delay_msec);
-            lastChannelValue10[mix] += stepPosition10;
-            if( lastChannelValue10[mix] > targetPosition10) { // Do not exceed targeted value.
-                lastChannelValue10[mix] = targetPosition10;
+        if( (posStep[mix] > 0) && (targetPosition > lastPosition[mix]) ) {
+            lastPosition[mix] += (posStep[mix] * frameScale) >> FRAME_SCALE_BITS;
+            if( lastPosition[mix] > targetPosition) { // Do not exceed targeted value.
+                lastPosition[mix] = targetPosition;
             }
 
-        } else if( (CFG->negDelay_sec[mix] > 0) && (targetPosition10 < lastChannelValue10[mix]) ) {
-            delay_msec = CFG->negDelay_sec[mix] * 100;
-            stepPosition10 = (int16_t)((int32_t)((CHANNELVALUE_MAX - CHANNELVALUE_MIN) * SCALING_F) * PPM_FRAME_TIME_usec / 1000 / delay_msec);
-            lastChannelValue10[mix] -= stepPosition10;
-            if( lastChannelValue10[mix] < targetPosition10) {
-                lastChannelValue10[mix] = targetPosition10;
+        } else if( (negStep[mix] > 0) && (targetPosition < lastPosition[mix]) ) {
+            lastPosition[mix] -= (negStep[mix] * frameScale) >> FRAME_SCALE_BITS;
+            if( lastPosition[mix] < targetPosition) {
+                lastPosition[mix] = targetPosition;
             }
 
         } else {
-            lastChannelValue10[mix] = targetPosition10;
+            lastPosition[mix] = targetPosition;
             continue;
         }
 
-        controls.logicalSet( mix, (channelValue_t)(lastChannelValue10[mix] / SCALING_F));
+        logical[mix] = Controls::limit( (channelValue_t)(lastPosition[mix] / DELAY_SCALE));
+    }
+}
+
+/* Precompute the steps per OUTPUT_FRAME_TIME_usec.
+ * posDelay_sec and negDelay_sec are scaled floats in 1/10 sec resolution.
+ */
+void ChannelDelay::updateSteps() {
+
+    for( uint8_t mix = 0; mix < MIX_CHANNELS; mix++) {
+        posStep[mix] = (CFG->posDelay_sec[mix] > 0) ? DELAY_TRAVEL_MSEC / ((int32_t)CFG->posDelay_sec[mix] * 100) : 0;
+        negStep[mix] = (CFG->negDelay_sec[mix] > 0) ? DELAY_TRAVEL_MSEC / ((int32_t)CFG->negDelay_sec[mix] * 100) : 0;
     }
 }
 
+void ChannelDelay::init() {
+
+    updateSteps();
+}
+
+bool ChannelDelay::checkActive() {
+
+    bool delayed = false;
+
+    for( channel_t ch = 0; ch < MIX_CHANNELS; ch++) {
+        if( CFG->posDelay_sec[ch] > 0 || CFG->negDelay_sec[ch] > 0) {
+            delayed = true;
+        }
+    }
+
+    /* lastPosition is not tracked while inactive. */
+    if( !delayed) {
+        resync = true;
+    }
+
+    return delayed;
+}
+
 void ChannelDelay::setDefaults() {
 
     INIT_NON_PHASED_CONFIGURATION(
@@ -102,8 +157,12 @@ void ChannelDelay::setDefaults() {
     )
 
     for( channel_t ch = 0; ch < MIX_CHANNELS; ch++) {
-        lastChannelValue10[ch] = 0;
+        lastPosition[ch] = 0;
     }
+
+    updateSteps();
+    lastRun_usec = micros();
+    resync = false;
 }
 
 /* From TableEditable */
@@ -139,4 +198,7 @@ void ChannelDelay::setValue( uint8_t row, uint8_t col, Cell *cell) {
     } else if( col == 1) {
         CFG->negDelay_sec[row] = cell->getFloat1();
     }
+
+    updateSteps();
+    updateActive();
 }
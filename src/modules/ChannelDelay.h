@@ -39,6 +39,8 @@
 
 #define CHANNELDELAY_MAX_SEC     (10)
 
+#define CHANNELDELAY_FRACTION_BITS  8
+
 typedef struct channelDelay_t {
 
     float1 posDelay_sec[MIX_CHANNELS];
@@ -51,13 +53,39 @@ class ChannelDelay : public Module {
     NON_PHASED_CONFIG( channelDelay_t)
 
     private:
-        int16_t lastChannelValue10[MIX_CHANNELS];
+        /* Channel positions and steps per frame are fixed point values
+         * with CHANNELDELAY_FRACTION_BITS fractional bits.
+         * Fractions of a step accumulate in the position, so long
+         * delays keep their precision.
+         */
+        int32_t lastPosition[MIX_CHANNELS];
+
+        /* Step per OUTPUT_FRAME_TIME_usec for each direction.
+         * 0 if there is no delay.
+         * Recomputed whenever the configuration changes.
+         */
+        int32_t posStep[MIX_CHANNELS];
+        int32_t negStep[MIX_CHANNELS];
+
+        /* The real frame time varies, e.g. with ENABLE_ADAPTIVE_PPM.
+         * Steps are scaled by the time since the last run.
+         */
+        unsigned long lastRun_usec;
+
+        bool resync;
+
+        void updateSteps();
+
+    protected:
+        /* From Module */
+        bool checkActive() final;
 
     public:
         ChannelDelay();
 
         /* From Module */
         void run( Controls &controls) final;
+        void init() final;
         void setDefaults() final;
         COMM_RC_t exportConfig( ImportExport *exporter, uint8_t *config) const;
         COMM_RC_t importConfig( ImportExport *importer, uint8_t *config) const;
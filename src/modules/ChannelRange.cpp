@@ -59,6 +59,7 @@ COMM_RC_t ChannelRange::importConfig( ImportExport *importer, uint8_t *config) c
 void ChannelRange::run( Controls &controls) {
 
     long v;
+    channelValue_t *logical = controls.logicalChannels();
 
     const AssignInput *assignInput = (AssignInput*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_ASSIGN_INPUT_TYPE);
 
@@ -66,13 +67,13 @@ void ChannelRange::run( Controls &controls) {
         channel_t in = assignInput->getInputChannel( ch);
 
         if( in < PORT_ANALOG_INPUT_COUNT) {
-            v = controls.logicalGet( ch);
+            v = logical[ch];
             if( v > 0) {
                 v = v * CFG->posRange_pct[in] / PERCENT_MAX_LIMIT;
             } else if( v < 0) {
                 v = v * CFG->negRange_pct[in] / PERCENT_MIN_LIMIT;
             }
-            controls.logicalSet( ch, (channelValue_t)v);
+            logical[ch] = Controls::limit( (channelValue_t)v);
         }
     }
 }
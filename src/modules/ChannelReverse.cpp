@@ -53,13 +53,20 @@ COMM_RC_t ChannelReverse::importConfig( ImportExport *importer, uint8_t *config)
 
 void ChannelReverse::run( Controls &controls) {
 
+    channelValue_t *input = controls.inputChannels();
+
     for( channel_t ch = 0; ch < PORT_ANALOG_INPUT_COUNT; ch++) {
         if( IS_BIT_SET( CFG->revBits, ch)) {
-            controls.inputSet( ch, -controls.inputGet(ch));
+            input[ch] = -input[ch];
         }
     }
 }
 
+bool ChannelReverse::checkActive() {
+
+    return CFG->revBits != 0;
+}
+
 void ChannelReverse::setDefaults() {
 
     INIT_NON_PHASED_CONFIGURATION(
@@ -97,4 +104,6 @@ void ChannelReverse::setValue( uint8_t row, uint8_t col, Cell *cell) {
     } else {
         BIT_CLEAR( CFG->revBits, row);
     }
+
+    updateActive();
 }
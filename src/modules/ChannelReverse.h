@@ -41,6 +41,10 @@ class ChannelReverse : public Module {
 
     NON_PHASED_CONFIG( channelReverse_t)
 
+    protected:
+        /* From Module */
+        bool checkActive() final;
+
     public:
         ChannelReverse();
 
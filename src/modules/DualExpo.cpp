@@ -88,33 +88,56 @@ COMM_RC_t DualExpo::importConfig( ImportExport *importer, uint8_t *config) const
     return importer->runImport( DICT_ptr(DualExpo), DICTROW_ptr(DualExpo), config, sizeof(dualExpo_t));
 }
 
+/* Channels with dual rate and expo */
+static const channel_t dualExpoChannel[DUAL_EXPO_CHANNELS] = {
+    CHANNEL_AILERON,
+    CHANNEL_ELEVATOR,
+    CHANNEL_RUDDER
+};
+
+/* Distance between two points of the lookup table and the response curve */
+#define EXPO_DX   (CHANNELVALUE_MAX_LIMIT / EXPO_LOOKUP_TABLE_SIZE)
+
+/* x / EXPO_DX for EXPO_DX == 50 without a division.
+ * Exact for 0 <= x < 43690.
+ */
+#define EXPO_DIV_DX( x)   (((long)(x) * 20972L) >> 20)
+
 void DualExpo::run( Controls &controls) {
 
-    /* Expo */
-    applyExpo( controls, CHANNEL_AILERON, CFG->expo[0]);
-    applyExpo( controls, CHANNEL_ELEVATOR, CFG->expo[1]);
-    applyExpo( controls, CHANNEL_RUDDER, CFG->expo[2]);
+    channelValue_t *logical = controls.logicalChannels();
+    const channelValue_t *c;
+    channelValue_t v;
+    channelValue_t w;
+    uint8_t interval;
+    bool negative;
 
-    /* Rate */
-    applyRate( controls, CHANNEL_AILERON, CFG->rate[0]);
-    applyRate( controls, CHANNEL_ELEVATOR, CFG->rate[1]);
-    applyRate( controls, CHANNEL_RUDDER, CFG->rate[2]);
-}
+    for( uint8_t i = 0; i < DUAL_EXPO_CHANNELS; i++) {
 
-void DualExpo::applyRate( Controls &controls, channel_t ch, percent_t pct) {
+        c = curve[i];
+        v = logical[dualExpoChannel[i]];
 
-    long v;
-    
-    v = controls.logicalGet( ch);
+        negative = (v < 0);
+        if( negative) {
+            v = -v;
+        }
 
-    v = v * pct / PERCENT_MAX;
+        if( v >= CHANNELVALUE_MAX_LIMIT) {
+            w = c[DUAL_EXPO_CURVE_POINTS -1];
+        } else {
+            interval = (uint8_t)EXPO_DIV_DX( v);
+            w = c[interval] + (channelValue_t)EXPO_DIV_DX( (long)(c[interval+1] - c[interval]) * (v - interval * EXPO_DX));
+        }
 
-    controls.logicalSet( ch, (channelValue_t)v);
+        logical[dualExpoChannel[i]] = negative ? -w : w;
+    }
 }
 
-void DualExpo::applyExpo( Controls &controls, channel_t ch, percent_t pct) {
+/* Compute the response for a positive channel value v.
+ * Expo interpolates the lookup table, rate scales the result.
+ */
+channelValue_t DualExpo::curveValue( channelValue_t v, percent_t expoPct, percent_t ratePct) const {
 
-    channelValue_t v;
     channelValue_t w;
     long e;
 
@@ -122,37 +145,42 @@ void DualExpo::applyExpo( Controls &controls, channel_t ch, percent_t pct) {
     channelValue_t y1;
     channelValue_t y2;
 
-    channelValue_t dx = CHANNELVALUE_MAX_LIMIT / EXPO_LOOKUP_TABLE_SIZE; // PCT_TO_CHANNEL( controls.rangeGet(ch)) / EXPO_LOOKUP_TABLE_SIZE;
-
     uint8_t interval;
-    bool negative = false;
-
-    v = controls.logicalGet( ch);
-
-    if( v < 0) {
-        negative = true;
-        v = -v;
-    }
 
     /* interval in range 0 to EXPO_LOOKUP_TABLE_SIZE-1 */
-    interval = (uint8_t)(v / dx);
+    interval = (uint8_t)(v / EXPO_DX);
 
     if( interval >= EXPO_LOOKUP_TABLE_SIZE) {
         interval = EXPO_LOOKUP_TABLE_SIZE -1;
     }
 
     /* x start of interval */
-    x1 = interval * dx;
+    x1 = interval * EXPO_DX;
 
     /* y start and end of interval */
     y1 = expoLookup[interval];
     y2 = expoLookup[interval+1];
 
     /* interpolate exponential value from table */
-    e = ((long)(v-x1) * (long)(y2-y1) / dx) + y1;
-    w = ((pct * e) + (100 - pct) * (long)v) / 100;
+    e = ((long)(v-x1) * (long)(y2-y1) / EXPO_DX) + y1;
+    w = Controls::limit( (channelValue_t)(((expoPct * e) + (100 - expoPct) * (long)v) / 100));
+
+    /* Rate */
+    return Controls::limit( (channelValue_t)((long)w * ratePct / PERCENT_MAX));
+}
 
-    controls.logicalSet( ch, (channelValue_t)(negative ? -w : w));
+void DualExpo::buildCurves() {
+
+    for( uint8_t i = 0; i < DUAL_EXPO_CHANNELS; i++) {
+        for( uint8_t p = 0; p < DUAL_EXPO_CURVE_POINTS; p++) {
+            curve[i][p] = curveValue( p * EXPO_DX, CFG->expo[i], CFG->rate[i]);
+        }
+    }
+}
+
+void DualExpo::init() {
+
+    buildCurves();
 }
 
 void DualExpo::setDefaults() {
@@ -176,7 +204,8 @@ void DualExpo::switchPhase(phase_t ph) {
     userInterface.cancelEdit( this);
 
     SWITCH_PHASE( ph);
-    
+    buildCurves();
+
     Phases *phases = (Phases*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_PHASES_TYPE);
     if( phases) {
         phaseName = phases->getPhaseName();
@@ -279,5 +308,6 @@ void DualExpo::setValue( uint8_t row, uint8_t col, Cell *cell) {
         } else {
             CFG->expo[(row-1) / 2] = cell->getInt8();
         }
+        buildCurves();
     }
 }
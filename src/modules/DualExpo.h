@@ -31,6 +31,11 @@
 
 #define DUAL_EXPO_CHANNELS 3
 
+/* Number of points of the response curve.
+ * One point every CHANNELVALUE_MAX_LIMIT / 25 from 0 to CHANNELVALUE_MAX_LIMIT.
+ */
+#define DUAL_EXPO_CURVE_POINTS 26
+
 typedef struct dualExpo_t {
 
     /* Dual Rate and expo for Aileron/Elevator/Rudder */
@@ -46,15 +51,22 @@ class DualExpo : public Module {
     private:
         bool postRefresh;
         const char *phaseName;
-        
-        void applyRate( Controls &controls, channel_t ch, percent_t pct);
-        void applyExpo( Controls &controls, channel_t ch, percent_t pct);
+
+        /* Combined expo and rate response of the current phase
+         * for the positive half of each channel.
+         * Rebuilt on phase switch, model load and edit.
+         */
+        channelValue_t curve[DUAL_EXPO_CHANNELS][DUAL_EXPO_CURVE_POINTS];
+
+        void buildCurves();
+        channelValue_t curveValue( channelValue_t v, percent_t expoPct, percent_t ratePct) const;
 
     public:
         DualExpo();
 
         /* From Module */
         void run( Controls &controls) final;
+        void init() final;
         void setDefaults() final;
         COMM_RC_t exportConfig( ImportExport *exporter, uint8_t *config) const;
         COMM_RC_t importConfig( ImportExport *importer, uint8_t *config) const;
@@ -60,11 +60,23 @@ void EngineCut::run( Controls &controls) {
     save = controls.evalSwitches( CFG->swState);
 
     if( save) {
-        controls.logicalSet( CHANNEL_THROTTLE, PCT_TO_CHANNEL(CFG->cut_pct));
+        controls.logicalChannels()[CHANNEL_THROTTLE] = Controls::limit( PCT_TO_CHANNEL(CFG->cut_pct));
     }
     
 }
 
+bool EngineCut::checkActive() {
+
+    if( IS_SWITCH_USED( CFG->swState)) {
+        return true;
+    }
+
+    /* run() is not called any more. */
+    save = false;
+
+    return false;
+}
+
 void EngineCut::setDefaults() {
 
     INIT_NON_PHASED_CONFIGURATION(
@@ -113,4 +125,6 @@ void EngineCut::setValue( uint8_t row, uint8_t col, Cell *cell) {
     } else {
         CFG->cut_pct = cell->getInt8();
     }
+
+    updateActive();
 }
@@ -43,6 +43,10 @@ class EngineCut : public Module {
     private:
         bool save;
 
+    protected:
+        /* From Module */
+        bool checkActive() final;
+
     public:
         EngineCut();
         bool isSave();
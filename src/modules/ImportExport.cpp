@@ -28,6 +28,10 @@
 #include "ModuleManager.h"
 
 extern ModuleManager moduleManager;
+#ifdef ENABLE_LATENCY_STATISTICS
+#include "Statistics.h"
+extern Statistics statistics;
+#endif
 extern void watchdog_reset();
 
 const uint8_t STATE_INACTIVE = 0;
@@ -250,15 +254,13 @@ void ImportExport::exportModulePhase(const DICTROW_t* row[], uint8_t* config)
     }
 }
 
-/* From Module */
-
 /* Initial state is STATE_CONNECTING.
  * In this state we are waiting for a connnect request.
  * Once the connect request is received we send an info packet.
  * The info packet contains the firmware release and the number of supported models.
 */
 
-void ImportExport::run(Controls& controls)
+void ImportExport::handleComm()
 {
     nameType_t cmd;
     char dType;
@@ -296,6 +298,22 @@ void ImportExport::run(Controls& controls)
             moduleManager.importModel(this);
             break;
 
+#ifdef ENABLE_MODULE_PROFILER
+        case COMM_PACKET_GET_PROFILE:
+            comm.nextField(&cmd, &dType, &width, &count);
+            state = STATE_EXPORTING;
+            moduleManager.exportProfile(this);
+            break;
+#endif
+
+#ifdef ENABLE_LATENCY_STATISTICS
+        case COMM_PACKET_GET_LATENCY:
+            comm.nextField(&cmd, &dType, &width, &count);
+            state = STATE_EXPORTING;
+            statistics.exportLatency(this);
+            break;
+#endif
+
         default:
             comm.nextField(&cmd, &dType, &width, &count);
             comm.open(COMM_PACKET_ERROR);
@@ -307,6 +325,8 @@ void ImportExport::run(Controls& controls)
     }
 }
 
+/* From Module */
+
 void ImportExport::setDefaults()
 {
     state = STATE_INACTIVE;
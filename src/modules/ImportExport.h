@@ -111,6 +111,9 @@ class ImportExport : public Module {
 
         void exportModulePhase( const DICTROW_t* row[], uint8_t* config);
 
+        /* Runs from the comm task, not from the module pipeline. */
+        bool checkActive() final { return false; }
+
     public:
         ImportExport( Stream &stream);
 
@@ -121,8 +124,11 @@ class ImportExport : public Module {
 
         bool findDictEntry( const DICTROW_t* row[], nameType_t cmd, uint8_t *dictDataType, size_t *dictOffset, size_t *dictSize, uint16_t *dictCount);
 
+        /* Process comm packets. Called from the comm task. */
+        void handleComm();
+
         /* From Module */
-        void run( Controls &controls) final;
+        void run( Controls &controls) final { }
         void setDefaults() final;
         COMM_RC_t exportConfig( ImportExport *exporter, uint8_t *config) const { return COMM_RC_OK; }
         COMM_RC_t importConfig( ImportExport *importer, uint8_t *config) const { return COMM_RC_OK; }
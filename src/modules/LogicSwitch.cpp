@@ -37,7 +37,32 @@ DICTROWA( r1, COMM_DATATYPE_UINTARR, COMM_FIELD_SWITCH_ARRAY, logicSwitch_t, typ
 DICTROWA( r2, COMM_DATATYPE_UINTARR, COMM_FIELD_STATEA_ARRAY, logicSwitch_t, swStateA, LOGIC_SWITCHES)
 DICTROWA( r3, COMM_DATATYPE_UINTARR, COMM_FIELD_STATEB_ARRAY, logicSwitch_t, swStateB, LOGIC_SWITCHES)
 DICTROWA( r4, COMM_DATATYPE_UINTARR, COMM_FIELD_STATEC_ARRAY, logicSwitch_t, swStateC, LOGIC_SWITCHES)
-DICT( LogicSwitch, COMM_SUBPACKET_LOGIC_SWITCH, &r1, &r2, &r3, &r4)
+DICTROWA( r5, COMM_DATATYPE_UINTARR, COMM_FIELD_STATED_ARRAY, logicSwitch_t, swStateD, LOGIC_SWITCHES)
+DICTROWA( r6, COMM_DATATYPE_UINTARR, COMM_FIELD_TRUTH_TABLE_ARRAY, logicSwitch_t, table, LOGIC_SWITCHES)
+DICT( LogicSwitch, COMM_SUBPACKET_LOGIC_SWITCH, &r1, &r2, &r3, &r4, &r5, &r6)
+
+/* Truth tables of the predefined functions.
+ * Same order as LogicTypes.
+ */
+static const logicTable_t logicPresets[LOGIC_SWITCH_TYPE_TABLE] = {
+    0x8888, // A & B
+    0xeeee, // A | B
+    0x8080, // A & B & C
+    0xfefe, // A | B | C
+    0xf8f8, // (A & B) | C
+    0xe0e0  // (A | B) & C
+};
+
+/* Configuration before input D and the truth table were added */
+typedef struct logicSwitchV1_t {
+
+    uint8_t  type[LOGIC_SWITCHES];
+
+    switch_t swStateA[LOGIC_SWITCHES];
+    switch_t swStateB[LOGIC_SWITCHES];
+    switch_t swStateC[LOGIC_SWITCHES];
+
+} logicSwitchV1_t;
 
 LogicSwitch::LogicSwitch() : Module( MODULE_LOGIC_SWITCH_TYPE, TEXT_MODULE_LOGIC_SWITCH, COMM_SUBPACKET_LOGIC_SWITCH) {
 
@@ -58,46 +83,21 @@ COMM_RC_t LogicSwitch::importConfig( ImportExport *importer, uint8_t *config) co
 
 void LogicSwitch::run( Controls &controls) {
 
-    bool swA;
-    bool swB;
-    bool swC;
-    bool result;
+    uint8_t inputs;
     switch_t logicSw;
 
     for( switch_t sw = 0; sw < LOGIC_SWITCHES; sw++) {
-        if( IS_SWITCH_UNUSED( CFG->swStateA[sw])
-            || IS_SWITCH_UNUSED( CFG->swStateB[sw])) {
+        if( IS_SWITCH_UNUSED( CFG->swStateA[sw])) {
             continue;
         }
 
-        swA = controls.evalSwitches( CFG->swStateA[sw]);
-        swB = controls.evalSwitches( CFG->swStateB[sw]);
-        swC = controls.evalSwitches( CFG->swStateC[sw]);
-
-        switch( CFG->type[sw]) {
-        case 0: // A & B
-            result = swA && swB;
-            break;    
-        case 1: // A | B
-            result = swA || swB;
-            break;    
-        case 2: // A & B & C
-            result = swA && swB && swC;
-            break;    
-        case 3: // A | B | C
-            result = swA || swB || swC;
-            break;    
-        case 4: // (A & B) | C
-            result = (swA && swB) || swC;
-            break;    
-        case 5: // (A | B) & C
-            result = (swA || swB) && swC;
-            break;
-        default:
-            result = false;  
-        }
+        /* Index into the truth table */
+        inputs = (uint8_t)controls.evalSwitches( CFG->swStateA[sw])
+               | ((uint8_t)controls.evalSwitches( CFG->swStateB[sw]) << 1)
+               | ((uint8_t)controls.evalSwitches( CFG->swStateC[sw]) << 2)
+               | ((uint8_t)controls.evalSwitches( CFG->swStateD[sw]) << 3);
 
-        if( result) {
+        if( getTable( sw) & ((logicTable_t)1 << inputs)) {
             logicSw = controls.getSwitchByType( SW_CONF_LOGIC, sw);
             if( IS_SWITCH_USED(logicSw)) {
                 controls.switchSet( logicSw, SW_STATE_1);
@@ -112,42 +112,77 @@ void LogicSwitch::setDefaults() {
 
         for( switch_t sw = 0; sw < LOGIC_SWITCHES; sw++) {
             CFG->type[sw] = 0;
+            CFG->table[sw] = logicPresets[0];
             INIT_SWITCH( CFG->swStateA[sw]);
             INIT_SWITCH( CFG->swStateB[sw]);
             INIT_SWITCH( CFG->swStateC[sw]);
+            INIT_SWITCH( CFG->swStateD[sw]);
         }
     )
 }
 
+bool LogicSwitch::migrateConfig( const uint8_t *config, moduleSize_t size) {
+
+    const logicSwitchV1_t *v1 = (const logicSwitchV1_t*)config;
+
+    if( size != sizeof( logicSwitchV1_t)) {
+        return false;
+    }
+
+    setDefaults();
+
+    for( switch_t sw = 0; sw < LOGIC_SWITCHES; sw++) {
+        CFG->type[sw] = (v1->type[sw] < LOGIC_SWITCH_TYPE_TABLE) ? v1->type[sw] : 0;
+        CFG->table[sw] = logicPresets[CFG->type[sw]];
+        CFG->swStateA[sw] = v1->swStateA[sw];
+        CFG->swStateB[sw] = v1->swStateB[sw];
+        CFG->swStateC[sw] = v1->swStateC[sw];
+    }
+
+    return true;
+}
+
+/* Predefined functions always use their preset table.
+ * The stored table is used for LOGIC_SWITCH_TYPE_TABLE and
+ * for an out of range type.
+ */
+logicTable_t LogicSwitch::getTable( switch_t sw) {
+
+    uint8_t type = CFG->type[sw];
+
+    return (type < LOGIC_SWITCH_TYPE_TABLE) ? logicPresets[type] : CFG->table[sw];
+}
+
 /* From TableEditable */
 
 uint8_t LogicSwitch::getRowCount() {
 
-    return 4 * LOGIC_SWITCHES;
+    return LOGIC_SWITCH_ROWS * LOGIC_SWITCHES;
 }
 
 const char *LogicSwitch::getRowName( uint8_t row) {
 
-    if( row % 4) {
+    if( row % LOGIC_SWITCH_ROWS) {
         return TEXT_MSG_NONE;
     } else {
-        controls.copySwitchName( switchName, (switch_t)(row/4) + LOGIC_SWITCHES_FIRST_IDX);
+        controls.copySwitchName( switchName, (switch_t)(row/LOGIC_SWITCH_ROWS) + LOGIC_SWITCHES_FIRST_IDX);
         return switchName;
     }
 }
 
 uint8_t LogicSwitch::getColCount( uint8_t row) {
 
-    return (row % 4) ? 2 : 1;
+    return (row % LOGIC_SWITCH_ROWS) ? 2 : 1;
 }
 
 void LogicSwitch::getValue( uint8_t row, uint8_t col, Cell *cell) {
 
-    uint8_t sw = row / 4;
-    uint8_t r = (row % 4);
+    uint8_t sw = row / LOGIC_SWITCH_ROWS;
+    uint8_t r = (row % LOGIC_SWITCH_ROWS);
 
     if( r == 0) {
-        cell->setList( 4, LogicTypes, TEXT_LOGIC_SW_TYPE_count, CFG->type[sw]);
+        cell->setList( 4, LogicTypes, TEXT_LOGIC_SW_TYPE_count,
+                       (CFG->type[sw] < LOGIC_SWITCH_TYPE_TABLE) ? CFG->type[sw] : LOGIC_SWITCH_TYPE_TABLE);
     } else if( r == 1) {
         if( col == 0) {
             cell->setLabel(2, TEXT_LOGIC_SW_A, 1);
@@ -166,21 +201,41 @@ void LogicSwitch::getValue( uint8_t row, uint8_t col, Cell *cell) {
         } else {
             cell->setSwitchState( 4, CFG->swStateC[sw]);
         }
+    } else if( r == 4) {
+        if( col == 0) {
+            cell->setLabel(2, TEXT_LOGIC_SW_D, 1);
+        } else {
+            cell->setSwitchState( 4, CFG->swStateD[sw]);
+        }
+    } else if( r == 5) {
+        if( col == 0) {
+            cell->setLabel(2, TEXT_LOGIC_SW_TABLE, 3);
+        } else {
+            cell->setInt32( 6, getTable( sw), 5, 0, 0xffff);
+        }
     }
 }
 
 void LogicSwitch::setValue( uint8_t row, uint8_t col, Cell *cell) {
 
-    uint8_t sw = row / 4;
-    uint8_t r = (row % 4);
+    uint8_t sw = row / LOGIC_SWITCH_ROWS;
+    uint8_t r = (row % LOGIC_SWITCH_ROWS);
 
     if( r == 0) {
         CFG->type[sw] = cell->getList();
+        if( CFG->type[sw] < LOGIC_SWITCH_TYPE_TABLE) {
+            CFG->table[sw] = logicPresets[CFG->type[sw]];
+        }
     } else if( r == 1 && col == 1) {
         CFG->swStateA[sw] = cell->getSwitchState();
     } else if( r == 2 && col == 1) {
         CFG->swStateB[sw] = cell->getSwitchState();
     } else if( r == 3 && col == 1) {
         CFG->swStateC[sw] = cell->getSwitchState();
+    } else if( r == 4 && col == 1) {
+        CFG->swStateD[sw] = cell->getSwitchState();
+    } else if( r == 5 && col == 1) {
+        CFG->table[sw] = (logicTable_t)cell->getInt32();
+        CFG->type[sw] = LOGIC_SWITCH_TYPE_TABLE;
     }
 }
@@ -29,6 +29,23 @@
 
 #include "Module.h"
 
+/* A logic switch is an arbitrary boolean function of up to
+ * 4 switch conditions A, B, C and D.
+ *
+ * The function is stored as a truth table. Bit n of the table is
+ * the result for the inputs n = DCBA, A being the lowest bit.
+ * Unassigned inputs are false. The logic switch is off if A is not assigned.
+ *
+ * type selects one of the predefined functions or LOGIC_SWITCH_TYPE_TABLE
+ * for a table entered by the user.
+ */
+#define LOGIC_SWITCH_TYPE_TABLE   (TEXT_LOGIC_SW_TYPE_count -1)
+
+/* UI rows per logic switch: type, A, B, C, D and table */
+#define LOGIC_SWITCH_ROWS         6
+
+typedef uint16_t logicTable_t;
+
 typedef struct logicSwitch_t {
 
     uint8_t  type[LOGIC_SWITCHES];
@@ -36,6 +53,9 @@ typedef struct logicSwitch_t {
     switch_t swStateA[LOGIC_SWITCHES];
     switch_t swStateB[LOGIC_SWITCHES];
     switch_t swStateC[LOGIC_SWITCHES];
+    switch_t swStateD[LOGIC_SWITCHES];
+
+    logicTable_t table[LOGIC_SWITCHES];
 
 } logicSwitch_t;
 
@@ -46,12 +66,15 @@ class LogicSwitch : public Module {
     private:
         char switchName[TEXT_SW_NAME_length +1];
 
+        logicTable_t getTable( switch_t sw);
+
     public:
         LogicSwitch();
 
         /* From Module */
         void run( Controls &controls) final;
         void setDefaults() final;
+        bool migrateConfig( const uint8_t *config, moduleSize_t size) final;
         COMM_RC_t exportConfig( ImportExport *exporter, uint8_t *config) const;
         COMM_RC_t importConfig( ImportExport *importer, uint8_t *config) const;
 
@@ -25,6 +25,7 @@
 */
 
 #include "Mixer.h"
+#include "MixProgram.h"
 
 extern const char* const LogicalChannelNames[LOGICAL_CHANNELS];
 
@@ -48,20 +49,6 @@ channelValue_t Mixer::mixValue( channelValue_t v, uint8_t mix) {
     return (channelValue_t)( ((long)(v) - (long)PCT_TO_CHANNEL( CFG->mixOffset[mix])) * (long)CFG->mixPct[mix] / 100L);
 }
 
-void Mixer::limitChannels( Controls &controls) {
-
-    for( channel_t ch = 0; ch < LOGICAL_CHANNELS; ch++) {
-        channelValue_t v = controls.logicalGet( ch);
-        if( v > CHANNELVALUE_MAX_LIMIT) {
-            controls.logicalSet( ch, CHANNELVALUE_MAX_LIMIT);
-            continue;
-        }
-        if( v < CHANNELVALUE_MIN_LIMIT ) {
-            controls.logicalSet( ch, CHANNELVALUE_MIN_LIMIT);
-        }
-    }
-}
-
 /* From Module */
 
 COMM_RC_t Mixer::exportConfig( ImportExport *exporter, uint8_t *config) const {
@@ -110,8 +97,64 @@ void Mixer::run( Controls &controls) {
             }
         }
     }
+}
+
+#ifdef ENABLE_MIX_PROGRAM
+extern MixProgram mixProgram;
+#endif
+
+void Mixer::compileMix( MixProgram &program) {
+
+#ifdef ENABLE_MIX_PROGRAM
+    mixOp_t *o;
+    channel_t targetChannel;
+
+    for( uint8_t mix = 0; mix < MIXER; mix++) {
+
+        if( IS_SWITCH_UNUSED( CFG->mixSw[mix]) || CFG->source[mix] >= LOGICAL_CHANNELS) {
+            continue;
+        }
+
+        targetChannel = CFG->target[mix];
+
+        o = program.emitMix( CFG->mixSw[mix], CFG->source[mix], CFG->mixPct[mix], CFG->mixOffset[mix]);
+        program.addTarget( o, targetChannel, false);
+
+        /* Some channels have a second auxiliary channel */
+        switch( targetChannel) {
+        case CHANNEL_AILERON:
+            program.addTarget( o, CHANNEL_AILERON2, true);
+            break;
+
+        case CHANNEL_FLAP:
+            program.addTarget( o, CHANNEL_FLAP2, false);
+            break;
+
+        case CHANNEL_SPOILER:
+            program.addTarget( o, CHANNEL_SPOILER2, false);
+            break;
+
+        default:
+            break;
+        }
+    }
+#endif
+}
+
+bool Mixer::checkActive() {
+
+#ifdef ENABLE_MIX_PROGRAM
+    /* Mixes are part of the mix program run by Model */
+    return false;
+#else
+    for( uint8_t mix = 0; mix < MIXER; mix++) {
+        if( IS_SWITCH_USED( CFG->mixSw[mix])) {
+            return true;
+        }
+    }
 
-    limitChannels( controls);
+    return false;
+#endif
 }
 
 void Mixer::setDefaults() {
@@ -202,4 +245,10 @@ void Mixer::setValue( uint8_t row, uint8_t col, Cell *cell) {
             CFG->mixOffset[(mix)] = cell->getInt8();
         }
     }
+
+#ifdef ENABLE_MIX_PROGRAM
+    mixProgram.invalidate();
+#endif
+
+    updateActive();
 }
@@ -29,6 +29,8 @@
 
 #include "Module.h"
 
+class MixProgram;
+
 typedef struct mixer_t {
 
     switch_t mixSw[MIXER];
@@ -53,11 +55,17 @@ class Mixer : public Module {
         char mixerName[5];
 
         channelValue_t mixValue( channelValue_t v, uint8_t mix);
-        void limitChannels( Controls &controls);
+
+    protected:
+        /* From Module */
+        bool checkActive() final;
 
     public:
         Mixer();
 
+        /* Append the operations of the current configuration to a mix program. */
+        void compileMix( MixProgram &program);
+
         /* From Module */
         void run( Controls &controls) final;
         void setDefaults() final;
@@ -25,6 +25,7 @@
 */
 
 #include "Model.h"
+#include "MixProgram.h"
 
 extern const char* const WingMixNames[TEXT_WINGMIX_count];
 extern const char* const MixNames[TEXT_MIX_count];
@@ -61,22 +62,122 @@ channelValue_t Model::mixValue( channelValue_t v, uint8_t mix) {
     return (channelValue_t)( ((long)(v) - (long)PCT_TO_CHANNEL( CFG->mixOffset[mix])) * (long)CFG->mixPct[mix] / 100L);
 }
 
-void Model::limitChannels( Controls &controls) {
+#ifdef ENABLE_MIX_PROGRAM
+extern MixProgram mixProgram;
+#endif
 
-    for( channel_t ch = 0; ch < LOGICAL_CHANNELS; ch++) {
-        channelValue_t v = controls.logicalGet( ch);
-        if( v > CHANNELVALUE_MAX_LIMIT) {
-            controls.logicalSet( ch, CHANNELVALUE_MAX_LIMIT);
-        } else if( v < CHANNELVALUE_MIN_LIMIT ) {
-            controls.logicalSet( ch, CHANNELVALUE_MIN_LIMIT);
+void Model::compileMix( MixProgram &program) {
+
+#ifdef ENABLE_MIX_PROGRAM
+    mixOp_t *o;
+    channel_t src;
+    uint8_t flags;
+
+    program.setWingMix( CFG->wingMix, CFG->qrDiffSw, CFG->qrDiffPct);
+
+    for( uint8_t mix = 0; mix < TEXT_MIX_count; mix++) {
+
+        if( IS_SWITCH_UNUSED( CFG->mixSw[mix])) {
+            continue;
+        }
+
+        flags = MIXOP_F_SAVED;
+
+        switch( mix) {
+        case MIX_AIL_RUD:
+        case MIX_AIL_FLP:
+            src = CHANNEL_AILERON;
+            break;
+        case MIX_SPL_AIL:
+        case MIX_SPL_FLP:
+        case MIX_SPL_ELV:
+            src = CHANNEL_SPOILER;
+            break;
+        case MIX_FLP_AIL:
+        case MIX_FLP_ELV:
+            src = CHANNEL_FLAP;
+            break;
+        case MIX_ELV_AIL:
+        case MIX_ELV_FLP:
+            src = CHANNEL_ELEVATOR;
+            break;
+        case MIX_RUD_ELV:
+            src = CHANNEL_RUDDER;
+            flags |= MIXOP_F_ABS;
+            break;
+        default:
+            continue;
+        }
+
+        o = program.emitMix( CFG->mixSw[mix], src, CFG->mixPct[mix], CFG->mixOffset[mix]);
+        if( o == nullptr) {
+            break;
+        }
+        o->flags |= flags;
+
+        switch( mix) {
+        case MIX_AIL_RUD:
+            program.addTarget( o, CHANNEL_RUDDER, false);
+            if( CFG->wingMix == WINGMIX_VTAIL) {
+                program.addTarget( o, CHANNEL_ELEVATOR, true);
+            }
+            break;
+
+        case MIX_AIL_FLP:
+            o->flags |= MIXOP_F_FLAPDIFF;
+            program.addTarget( o, CHANNEL_FLAP, false);
+            program.addTarget( o, CHANNEL_FLAP2, true);
+            break;
+
+        case MIX_SPL_AIL:
+        case MIX_FLP_AIL:
+        case MIX_ELV_AIL:
+            program.addTarget( o, CHANNEL_AILERON, false);
+            program.addTarget( o, CHANNEL_AILERON2, false);
+            if( CFG->wingMix == WINGMIX_DELTA) {
+                program.addTarget( o, CHANNEL_ELEVATOR, false);
+            }
+            break;
+
+        case MIX_SPL_FLP:
+        case MIX_ELV_FLP:
+            program.addTarget( o, CHANNEL_FLAP, false);
+            program.addTarget( o, CHANNEL_FLAP2, false);
+            break;
+
+        case MIX_SPL_ELV:
+        case MIX_FLP_ELV:
+        case MIX_RUD_ELV:
+            program.addTarget( o, CHANNEL_ELEVATOR, false);
+            if( CFG->wingMix == WINGMIX_VTAIL) {
+                program.addTarget( o, CHANNEL_RUDDER, false);
+            } else if( CFG->wingMix == WINGMIX_DELTA) {
+                program.addTarget( o, CHANNEL_AILERON, false);
+            }
+            break;
+
+        default:
+            break;
         }
     }
+#endif
 }
 
 /* From Module */
 
+void Model::init() {
+
+#ifdef ENABLE_MIX_PROGRAM
+    mixProgram.invalidate();
+#endif
+}
+
 void Model::run( Controls &controls) {
 
+#ifdef ENABLE_MIX_PROGRAM
+    /* Runs Model, Mixer and PhasesTrim */
+    mixProgram.run( controls);
+#else
     channelValue_t ail;
     channelValue_t elv;
     channelValue_t rud;
@@ -150,8 +251,6 @@ void Model::run( Controls &controls) {
         break;
     }
 
-    limitChannels( controls);
-
     for( uint8_t mix = 0; mix < TEXT_MIX_count; mix++) {
 
         if( controls.evalSwitches( CFG->mixSw[mix])) {
@@ -260,8 +359,7 @@ void Model::run( Controls &controls) {
             }
         }
     }
-
-    limitChannels( controls);
+#endif
 }
 
 void Model::setDefaults() {
@@ -356,4 +454,8 @@ void Model::setValue( uint8_t row, uint8_t col, Cell *cell) {
             CFG->mixOffset[(row/2) -2] = cell->getInt8();
         }
     }
+
+#ifdef ENABLE_MIX_PROGRAM
+    mixProgram.invalidate();
+#endif
 }
@@ -33,6 +33,8 @@
 #define MODEL_ID_MIN        ((configBlockID_t)1)
 #define MODEL_ID_MAX        CONFIG_MODEL_COUNT
 
+class MixProgram;
+
 typedef uint8_t wingMix_t;
 
 /* Make sure the defines are in the same order as the 
@@ -79,15 +81,18 @@ class Model : public Module {
 
     private:
         channelValue_t mixValue( channelValue_t v, uint8_t mix);
-        void limitChannels( Controls &controls);
 
     public:
         Model();
 
         char *getModelName() { return CFG->modelName; }
 
+        /* Append the operations of the current configuration to a mix program. */
+        void compileMix( MixProgram &program);
+
         /* From Module */
         void run( Controls &controls) final;
+        void init() final;
         void setDefaults() final;
         COMM_RC_t exportConfig( ImportExport *exporter, uint8_t *config) const;
         COMM_RC_t importConfig( ImportExport *importer, uint8_t *config) const;
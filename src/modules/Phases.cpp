@@ -89,6 +89,11 @@ void Phases::run( Controls &controls) {
     }
 }
 
+bool Phases::checkActive() {
+
+    return IS_SWITCH_USED( CFG->sw);
+}
+
 void Phases::setDefaults() {
 
     INIT_NON_PHASED_CONFIGURATION(
@@ -147,4 +152,6 @@ void Phases::setValue( uint8_t row, uint8_t col, Cell *cell) {
     } else {
         CFG->phaseName[row-1] = cell->getList();
     }
+
+    updateActive();
 }
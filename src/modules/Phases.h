@@ -45,6 +45,10 @@ class Phases : public Module {
 
         char phaseText[5];
 
+    protected:
+        /* From Module */
+        bool checkActive() final;
+
     public:
         Phases();
 
@@ -26,10 +26,15 @@
 
 #include "PhasesTrim.h"
 #include "ModuleManager.h"
+#include "MixProgram.h"
 
 extern TextUI userInterface;
 extern ModuleManager moduleManager;
 
+#ifdef ENABLE_MIX_PROGRAM
+extern MixProgram mixProgram;
+#endif
+
 extern const char* const LogicalChannelNames[LOGICAL_CHANNELS];
 
 /* The import/export dictionary. 
@@ -86,6 +91,52 @@ void PhasesTrim::run( Controls &controls) {
     }
 }
 
+void PhasesTrim::compileMix( MixProgram &program) {
+
+#ifdef ENABLE_MIX_PROGRAM
+    mixOp_t *o;
+
+    for( channel_t pc = 0; pc < PHASED_TRIM_CHANNELS; pc++) {
+
+        if( CFG->trim_pct[pc] == 0) {
+            continue;
+        }
+
+        o = program.emitOffset( CFG->trim_pct[pc]);
+
+        if( pc == 0) {
+            program.addTarget( o, CHANNEL_AILERON, false);
+            program.addTarget( o, CHANNEL_AILERON2, false);
+        } else if( pc == 1) {
+            program.addTarget( o, CHANNEL_ELEVATOR, false);
+        } else if( pc == 2) {
+            program.addTarget( o, CHANNEL_FLAP, false);
+            program.addTarget( o, CHANNEL_FLAP2, false);
+        } else {
+            program.addTarget( o, CHANNEL_SPOILER, false);
+            program.addTarget( o, CHANNEL_SPOILER2, false);
+        }
+    }
+#endif
+}
+
+bool PhasesTrim::checkActive() {
+
+#ifdef ENABLE_MIX_PROGRAM
+    /* Trims are part of the mix program run by Model */
+    return false;
+#else
+    /* Trims of the current phase only. Recomputed on phase switch. */
+    for( channel_t pc = 0; pc < PHASED_TRIM_CHANNELS; pc++) {
+        if( CFG->trim_pct[pc] != 0) {
+            return true;
+        }
+    }
+
+    return false;
+#endif
+}
+
 void PhasesTrim::setDefaults() {
 
     INIT_PHASED_CONFIGURATION(
@@ -106,6 +157,10 @@ void PhasesTrim::switchPhase(phase_t ph) {
     userInterface.cancelEdit( this);
 
     SWITCH_PHASE( ph);
+
+#ifdef ENABLE_MIX_PROGRAM
+    mixProgram.invalidate();
+#endif
     
     Phases *phases = (Phases*)moduleManager.getModuleByType( MODULE_SET_MODEL, MODULE_PHASES_TYPE);
     if( phases) {
@@ -181,4 +236,10 @@ void PhasesTrim::setValue( uint8_t row, uint8_t col, Cell *cell) {
             CFG->trim_pct[row-1] = cell->getInt8();    
         }
     }
+
+#ifdef ENABLE_MIX_PROGRAM
+    mixProgram.invalidate();
+#endif
+
+    updateActive();
 }
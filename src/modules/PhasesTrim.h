@@ -31,6 +31,8 @@
 
 #define PHASED_TRIM_CHANNELS 4
 
+class MixProgram;
+
 typedef struct phasesTrim_t {
 
     percent_t trim_pct[PHASED_TRIM_CHANNELS];
@@ -45,9 +47,16 @@ class PhasesTrim : public Module {
         bool postRefresh;
         const char *phaseName;
 
+    protected:
+        /* From Module */
+        bool checkActive() final;
+
     public:
         PhasesTrim();
 
+        /* Append the operations of the current phase to a mix program. */
+        void compileMix( MixProgram &program);
+
         /* From Module */
         void run( Controls &controls) final;
         void setDefaults() final;
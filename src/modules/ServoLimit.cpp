@@ -25,9 +25,14 @@
 */
 
 #include "ServoLimit.h"
+#include "OutputProgram.h"
 
 extern const char* const OutputChannelNames[PPM_CHANNELS];
 
+#ifdef ENABLE_OUTPUT_PROGRAM
+extern OutputProgram outputProgram;
+#endif
+
 /* The import/export dictionary. 
  * See ImportExport.h
  */
@@ -52,21 +57,50 @@ COMM_RC_t ServoLimit::importConfig( ImportExport *importer, uint8_t *config) con
 
 /* From Module */
 
+void ServoLimit::compileOutput( OutputProgram &program) {
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        program.setLimits( ch, CFG->negLimit_pct[ch], CFG->posLimit_pct[ch]);
+    }
+#endif
+}
+
+bool ServoLimit::checkActive() {
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    /* Part of the output program run by ServoRemap */
+    return false;
+#else
+    return true;
+#endif
+}
+
+/* End of the output stage.
+ * Output channels are limited to CHANNELVALUE_MIN_LIMIT/CHANNELVALUE_MAX_LIMIT
+ * and the configured servo limits here.
+ */
 void ServoLimit::run( Controls &controls) {
 
+    channelValue_t *output = controls.outputChannels();
     channelValue_t v;
+    channelValue_t limit;
 
     for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
 
-        v = PCT_TO_CHANNEL( CFG->posLimit_pct[ch]);
-        if( controls.outputGet( ch) > v) {
-            controls.outputSet( ch, v);
+        v = Controls::limit( output[ch]);
+
+        limit = PCT_TO_CHANNEL( CFG->posLimit_pct[ch]);
+        if( v > limit) {
+            v = Controls::limit( limit);
         }
 
-        v = PCT_TO_CHANNEL( CFG->negLimit_pct[ch]);
-        if( controls.outputGet( ch) < v) {
-            controls.outputSet( ch, v);
+        limit = PCT_TO_CHANNEL( CFG->negLimit_pct[ch]);
+        if( v < limit) {
+            v = Controls::limit( limit);
         }
+
+        output[ch] = v;
     }
 }
 
@@ -115,4 +149,8 @@ void ServoLimit::setValue( uint8_t row, uint8_t col, Cell *cell) {
     } else {
         CFG->posLimit_pct[row] = cell->getInt8();
     }
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    outputProgram.invalidate();
+#endif
 }
@@ -29,6 +29,8 @@
 
 #include "Module.h"
 
+class OutputProgram;
+
 typedef struct servoLimit_t {
 
     percent_t posLimit_pct[PPM_CHANNELS];
@@ -40,9 +42,16 @@ class ServoLimit : public Module {
 
     NON_PHASED_CONFIG( servoLimit_t)
 
+    protected:
+        /* From Module */
+        bool checkActive() final;
+
     public:
         ServoLimit();
 
+        /* Set the operations of the current configuration in an output program. */
+        void compileOutput( OutputProgram &program);
+
         /* From Module */
         void run( Controls &controls) final;
         void setDefaults() final;
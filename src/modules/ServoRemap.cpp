@@ -25,10 +25,15 @@
 */
 
 #include "ServoRemap.h"
+#include "OutputProgram.h"
 
 extern const char* const LogicalChannelNames[LOGICAL_CHANNELS];
 extern const char* const OutputChannelNames[PPM_CHANNELS];
 
+#ifdef ENABLE_OUTPUT_PROGRAM
+extern OutputProgram outputProgram;
+#endif
+
 /* The import/export dictionary. 
  * See ImportExport.h
  */
@@ -52,11 +57,37 @@ COMM_RC_t ServoRemap::importConfig( ImportExport *importer, uint8_t *config) con
     return importer->runImport( DICT_ptr(ServoRemap), DICTROW_ptr(ServoRemap), config, sizeof(servoRemap_t));
 }
 
+void ServoRemap::compileOutput( OutputProgram &program) {
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        program.setSource( ch, CFG->source[ch]);
+    }
+#endif
+}
+
+void ServoRemap::init() {
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    outputProgram.invalidate();
+#endif
+}
+
 void ServoRemap::run( Controls &controls) {
 
+#ifdef ENABLE_OUTPUT_PROGRAM
+    /* Runs ServoRemap, ServoReverse, ServoSubtrim, ServoTest and ServoLimit */
+    outputProgram.run( controls);
+#else
+    const channelValue_t *logical = controls.logicalChannels();
+    channelValue_t *output = controls.outputChannels();
+    channel_t source;
+
     for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
-        controls.outputSet( ch, controls.logicalGet( CFG->source[ch]));
+        source = CFG->source[ch];
+        output[ch] = (source < LOGICAL_CHANNELS) ? logical[source] : CHANNELVALUE_MID;
     }
+#endif
 }
 
 void ServoRemap::setDefaults() {
@@ -118,4 +149,8 @@ void ServoRemap::setValue( uint8_t row, uint8_t col, Cell *cell) {
     if( col == 1) {
         CFG->source[row] = cell->getList();
     }
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    outputProgram.invalidate();
+#endif
 }
@@ -29,6 +29,8 @@
 
 #include "Module.h"
 
+class OutputProgram;
+
 /* Assign logical channels to servo channels */
 
 typedef struct servoRemap_t {
@@ -50,8 +52,12 @@ class ServoRemap : public Module {
          */
         channel_t getSourceForChannel( channel_t ch) { return ch < PPM_CHANNELS ? CFG->source[ch] : 0; }
 
+        /* Set the operations of the current configuration in an output program. */
+        void compileOutput( OutputProgram &program);
+
         /* From Module */
         void run( Controls &controls) final;
+        void init() final;
         void setDefaults() final;
         COMM_RC_t exportConfig( ImportExport *exporter, uint8_t *config) const;
         COMM_RC_t importConfig( ImportExport *importer, uint8_t *config) const;
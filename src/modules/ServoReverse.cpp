@@ -25,9 +25,14 @@
 */
 
 #include "ServoReverse.h"
+#include "OutputProgram.h"
 
 extern const char* const OutputChannelNames[PPM_CHANNELS];
 
+#ifdef ENABLE_OUTPUT_PROGRAM
+extern OutputProgram outputProgram;
+#endif
+
 /* The import/export dictionary. 
  * See ImportExport.h
  */
@@ -53,11 +58,34 @@ COMM_RC_t ServoReverse::importConfig( ImportExport *importer, uint8_t *config) c
 
 void ServoReverse::run( Controls &controls) {
 
+    channelValue_t *output = controls.outputChannels();
+
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        if( IS_BIT_SET( CFG->revBits, ch)) {
+            output[ch] = -output[ch];
+        }
+    }
+}
+
+void ServoReverse::compileOutput( OutputProgram &program) {
+
+#ifdef ENABLE_OUTPUT_PROGRAM
     for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
         if( IS_BIT_SET( CFG->revBits, ch)) {
-            controls.outputSet( ch, -controls.outputGet(ch));
+            program.setReverse( ch);
         }
     }
+#endif
+}
+
+bool ServoReverse::checkActive() {
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    /* Part of the output program run by ServoRemap */
+    return false;
+#else
+    return CFG->revBits != 0;
+#endif
 }
 
 void ServoReverse::setDefaults() {
@@ -98,4 +126,10 @@ void ServoReverse::setValue( uint8_t row, uint8_t col, Cell *cell) {
     } else {
         BIT_CLEAR( CFG->revBits, row);
     }
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    outputProgram.invalidate();
+#endif
+
+    updateActive();
 }
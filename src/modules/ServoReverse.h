@@ -29,6 +29,8 @@
 
 #include "Module.h"
 
+class OutputProgram;
+
 /* Reverse servo directon */
 
 typedef struct servoReverse_t {
@@ -41,9 +43,16 @@ class ServoReverse : public Module {
 
     NON_PHASED_CONFIG( servoReverse_t)
 
+    protected:
+        /* From Module */
+        bool checkActive() final;
+
     public:
         ServoReverse();
 
+        /* Set the operations of the current configuration in an output program. */
+        void compileOutput( OutputProgram &program);
+
         /* From Module */
         void run( Controls &controls) final;
         void setDefaults() final;
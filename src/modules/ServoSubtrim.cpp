@@ -25,9 +25,14 @@
 */
 
 #include "ServoSubtrim.h"
+#include "OutputProgram.h"
 
 extern const char* const OutputChannelNames[PPM_CHANNELS];
 
+#ifdef ENABLE_OUTPUT_PROGRAM
+extern OutputProgram outputProgram;
+#endif
+
 /* The import/export dictionary. 
  * See ImportExport.h
  */
@@ -53,9 +58,37 @@ COMM_RC_t ServoSubtrim::importConfig( ImportExport *importer, uint8_t *config) c
 
 void ServoSubtrim::run( Controls &controls) {
 
+    channelValue_t *output = controls.outputChannels();
+
+    /* Not limited here. See ServoLimit. */
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        output[ch] += PCT_TO_CHANNEL( CFG->trim_pct[ch]);
+    }
+}
+
+void ServoSubtrim::compileOutput( OutputProgram &program) {
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        program.setOffset( ch, CFG->trim_pct[ch]);
+    }
+#endif
+}
+
+bool ServoSubtrim::checkActive() {
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    /* Part of the output program run by ServoRemap */
+    return false;
+#else
     for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
-        controls.outputSet( ch, controls.outputGet( ch) + PCT_TO_CHANNEL( CFG->trim_pct[ch]));
+        if( CFG->trim_pct[ch] != 0) {
+            return true;
+        }
     }
+
+    return false;
+#endif
 }
 
 void ServoSubtrim::setDefaults() {
@@ -94,4 +127,10 @@ void ServoSubtrim::getValue( uint8_t row, uint8_t col, Cell *cell) {
 void ServoSubtrim::setValue( uint8_t row, uint8_t col, Cell *cell) {
 
     CFG->trim_pct[row] = cell->getInt8();
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    outputProgram.invalidate();
+#endif
+
+    updateActive();
 }
@@ -29,6 +29,8 @@
 
 #include "Module.h"
 
+class OutputProgram;
+
 typedef struct servoSubtrim_t {
 
     percent_t trim_pct[PPM_CHANNELS];
@@ -39,9 +41,16 @@ class ServoSubtrim : public Module {
 
     NON_PHASED_CONFIG( servoSubtrim_t)
 
+    protected:
+        /* From Module */
+        bool checkActive() final;
+
     public:
         ServoSubtrim();
 
+        /* Set the operations of the current configuration in an output program. */
+        void compileOutput( OutputProgram &program);
+
         /* From Module */
         void run( Controls &controls) final;
         void setDefaults() final;
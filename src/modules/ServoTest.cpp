@@ -35,11 +35,7 @@
 
 extern ModuleManager moduleManager;
 
-#define TEST_COUNT 7
-
-const uint8_t TEST_OFF = 3;
-
-const char* const testNames[TEST_COUNT] {
+const char* const testNames[SERVOTEST_COUNT] {
 
     "-125%",
     "-100%",
@@ -58,15 +54,30 @@ ServoTest::ServoTest() : Module( MODULE_SERVO_TEST_TYPE, TEXT_MODULE_SERVO_TEST,
     setDefaults();
 }
 
+bool ServoTest::isTesting() const {
+
+    return testNo != SERVOTEST_OFF;
+}
+
 /* From Module */
 
+bool ServoTest::checkActive() {
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    /* Called by the output program while a test is running */
+    return false;
+#else
+    return true;
+#endif
+}
+
 void ServoTest::run( Controls &controls) {
 
-    if( testNo != TEST_OFF) { // off
+    if( testNo != SERVOTEST_OFF) {
 
         if( doInit) {
             for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
-                lastV[ch] = controls.outputGet( ch);
+                lastV[ch] = Controls::limit( controls.outputGet( ch));
                 increment[ch] = INCREMENT;
             }
             doInit = false;
@@ -82,21 +93,19 @@ void ServoTest::run( Controls &controls) {
             }
 
             switch( testNo) {
-            case 0: // -125%
+            case SERVOTEST_MIN_LIMIT: // -125%
                 moveTo( ch, CHANNELVALUE_MIN_LIMIT);
                 break;
 
-            case 1: // -100%
+            case SERVOTEST_MIN: // -100%
                 moveTo( ch, CHANNELVALUE_MIN);
                 break;
 
-            case 2: // 0%
+            case SERVOTEST_MID: // 0%
                 moveTo( ch, CHANNELVALUE_MID);
                 break;
 
-//            case 3: off
-
-            case 4: // Sweep
+            case SERVOTEST_SWEEP:
                 lastV[ch] += increment[ch];
 
                 if( lastV[ch] > CHANNELVALUE_MAX) {
@@ -108,11 +117,11 @@ void ServoTest::run( Controls &controls) {
                 }
                 break;
 
-            case 5: // 100%
+            case SERVOTEST_MAX: // 100%
                 moveTo( ch, CHANNELVALUE_MAX);
                 break;
 
-            case 6: // 125%
+            case SERVOTEST_MAX_LIMIT: // 125%
                 moveTo( ch, CHANNELVALUE_MAX_LIMIT);
                 break;
             }
@@ -122,6 +131,15 @@ void ServoTest::run( Controls &controls) {
     }
 }
 
+void ServoTest::setTest( uint8_t test) {
+
+    /* Start from the current output values */
+    if( testNo == SERVOTEST_OFF && test != SERVOTEST_OFF ) {
+        doInit = true;
+    }
+    testNo = test;
+}
+
 void ServoTest::moveTo( channel_t ch, channelValue_t v) {
 
     if (lastV[ch] < v)
@@ -144,7 +162,7 @@ void ServoTest::moveTo( channel_t ch, channelValue_t v) {
 
 void ServoTest::setDefaults() {
 
-    testNo = TEST_OFF; // test off
+    testNo = SERVOTEST_OFF;
     doInit = false;
 }
 
@@ -172,17 +190,11 @@ uint8_t ServoTest::getColCount( uint8_t row) {
 
 void ServoTest::getValue( uint8_t row, uint8_t col, Cell *cell) {
 
-    cell->setList( 5, testNames, TEST_COUNT, testNo);
+    cell->setList( 5, testNames, SERVOTEST_COUNT, testNo);
 }
 
 void ServoTest::setValue( uint8_t row, uint8_t col, Cell *cell) {
 
-    uint8_t newTest;
-
-    newTest = cell->getList(); 
-    if( testNo == TEST_OFF && newTest != TEST_OFF ) {
-        doInit = true;
-    }
-    testNo = newTest;
+    setTest( cell->getList());
 }
 
@@ -31,9 +31,24 @@
 
 /* Servo testing */
 
+/* Tests in the order of the selection list */
+#define SERVOTEST_MIN_LIMIT     ((uint8_t)0)
+#define SERVOTEST_MIN           ((uint8_t)1)
+#define SERVOTEST_MID           ((uint8_t)2)
+#define SERVOTEST_OFF           ((uint8_t)3)
+#define SERVOTEST_SWEEP         ((uint8_t)4)
+#define SERVOTEST_MAX           ((uint8_t)5)
+#define SERVOTEST_MAX_LIMIT     ((uint8_t)6)
+
+#define SERVOTEST_COUNT         ((uint8_t)7)
+
 class ServoTest : public Module {
 
     NO_CONFIG()
+
+    protected:
+        /* From Module */
+        bool checkActive() final;
     
     private:
         uint8_t testNo;
@@ -46,6 +61,12 @@ class ServoTest : public Module {
     public:
         ServoTest();
 
+        /* True while a test overrides the output channels */
+        bool isTesting() const;
+
+        /* Start one of the SERVOTEST_* tests. SERVOTEST_OFF stops testing. */
+        void setTest( uint8_t test);
+
         /* From Module */
         void run( Controls &controls) final;
         void setDefaults() final;
@@ -25,8 +25,27 @@
 */
 
 #include "Statistics.h"
+#include "ModuleManager.h"
 
-#define STATISTIC_COUNT 8
+#ifdef ENABLE_MODULE_PROFILER
+extern ModuleManager moduleManager;
+#endif
+
+#define STATISTIC_COUNT 10
+
+/* With ENABLE_LATENCY_STATISTICS the statistic rows are followed by
+ * a header row, a min/avg/max row and one row per histogram bucket.
+ */
+#ifdef ENABLE_LATENCY_STATISTICS
+#define LATENCY_ROW     STATISTIC_COUNT
+#define STATISTIC_ROWS  (STATISTIC_COUNT + 2 + LATENCY_BUCKETS)
+
+const char* const latencyBucketNames[LATENCY_BUCKETS] {
+    " <4ms", " <8ms", "<12ms", "<16ms", "<20ms", "<24ms", "<28ms", ">28ms"
+};
+#else
+#define STATISTIC_ROWS  STATISTIC_COUNT
+#endif
 
 const char* const statisticNames[STATISTIC_COUNT] {
     TEXT_STATISTIC_TIMING,
@@ -35,8 +54,10 @@ const char* const statisticNames[STATISTIC_COUNT] {
     TEXT_STATISTIC_MODULE,
     TEXT_STATISTIC_PPMOVER,
     TEXT_STATISTIC_FRAMETIME,
+    TEXT_STATISTIC_FRAMEMIN,
     TEXT_STATISTIC_WDT,
-    TEXT_STATISTIC_MEMFREE
+    TEXT_STATISTIC_MEMFREE,
+    TEXT_STATISTIC_MODULES_RUN
 };
 
 Statistics::Statistics() : Module( MODULE_STATISTICS_TYPE, TEXT_MODULE_STATISTICS, COMM_SUBPACKET_NONE) {
@@ -58,6 +79,12 @@ void Statistics::updateModulesTime( uint16_t t) {
     }
 }
 
+/* Number of active modules run in the last frame. */
+void Statistics::updateModulesRun( uint8_t c) {
+
+    modulesRun = c;
+}
+
 void Statistics::updatePPMOverrun( uint16_t c) {
 
     if( c > ppmOverrun) {
@@ -65,10 +92,16 @@ void Statistics::updatePPMOverrun( uint16_t c) {
     }
 }
 
-void Statistics::updateFrameTime( timingUsec_t t) {
+/* Shortest and longest output frame since start.
+ * Both differ only with adaptive PPM or a late frame.
+ */
+void Statistics::updateFrameTime( timingUsec_t minT, timingUsec_t maxT) {
 
-    if( t > maxFrameTime) {
-        maxFrameTime = t;
+    if( maxT > maxFrameTime) {
+        maxFrameTime = maxT;
+    }
+    if( minT != 0 && (minFrameTime == 0 || minT < minFrameTime)) {
+        minFrameTime = minT;
     }
 }
 
@@ -84,6 +117,56 @@ void Statistics::updateMemFree( size_t m) {
     memfree = m;
 }
 
+#ifdef ENABLE_LATENCY_STATISTICS
+/* Age of the ADC snapshot when the frame carrying it started. */
+void Statistics::updateLatency( uint32_t usec) {
+
+    /* Not narrowed, long stalls must end up in the last bucket */
+    uint32_t bucket;
+
+    if( latencyCount == 0 || usec < latencyMin_usec) {
+        latencyMin_usec = usec;
+    }
+    if( usec > latencyMax_usec) {
+        latencyMax_usec = usec;
+    }
+
+    /* Keep a running average without overflowing the sum. */
+    if( latencyCount == UINT16_MAX || latencySum_usec > UINT32_MAX - usec) {
+        latencySum_usec /= 2;
+        latencyCount /= 2;
+    }
+    latencySum_usec += usec;
+    latencyCount++;
+
+    bucket = usec / LATENCY_BUCKET_usec;
+    if( bucket >= LATENCY_BUCKETS) {
+        bucket = LATENCY_BUCKETS -1;
+    }
+    if( latencyHist[bucket] < UINT16_MAX) {
+        latencyHist[bucket]++;
+    }
+}
+
+uint32_t Statistics::getAvgLatency() const {
+
+    return latencyCount == 0 ? 0 : latencySum_usec / latencyCount;
+}
+
+void Statistics::exportLatency( ImportExport *exporter) const {
+
+    Comm& comm = exporter->getComm();
+
+    comm.open( COMM_PACKET_LATENCY);
+    comm.addUInt32( COMM_FIELD_LATENCY_MIN, latencyMin_usec);
+    comm.addUInt32( COMM_FIELD_LATENCY_AVG, getAvgLatency());
+    comm.addUInt32( COMM_FIELD_LATENCY_MAX, latencyMax_usec);
+    comm.addUIntArr( COMM_FIELD_LATENCY_HIST, (const byte*)latencyHist, sizeof( uint16_t), LATENCY_BUCKETS);
+    comm.close();
+    comm.write();
+}
+#endif
+
 bool Statistics::debugTiming() const {
 
     return dumpTiming;
@@ -104,10 +187,21 @@ void Statistics::setDefaults() {
 
     timeUI_msec = 0;
     timeModules_msec = 0;
+    modulesRun = 0;
     wdTimeout = 0;
     ppmOverrun = 0;
     maxFrameTime = 0;
+    minFrameTime = 0;
     memfree = 0;
+#ifdef ENABLE_LATENCY_STATISTICS
+    latencyMin_usec = 0;
+    latencyMax_usec = 0;
+    latencySum_usec = 0;
+    latencyCount = 0;
+    for( uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+        latencyHist[i] = 0;
+    }
+#endif
     dumpTiming = false;
     dumpOverrun = false;
 }
@@ -119,23 +213,122 @@ bool Statistics::isRowEditable( uint8_t row) {
     return (row < 2);
 }
 
+/* With ENABLE_MODULE_PROFILER the statistic rows are followed by
+ * a header row and two rows per profiled module:
+ *   module name
+ *   min, avg, max run time in usec
+ */
 uint8_t Statistics::getRowCount() {
 
-    return STATISTIC_COUNT;
+#ifdef ENABLE_MODULE_PROFILER
+    return STATISTIC_ROWS + 1 + 2 * moduleManager.getProfiler()->getCount();
+#else
+    return STATISTIC_ROWS;
+#endif
 }
 
 const char *Statistics::getRowName( uint8_t row) {
 
+#ifdef ENABLE_MODULE_PROFILER
+    if( row == STATISTIC_ROWS) {
+        return TEXT_STATISTIC_PROFILE;
+    } else if( row > STATISTIC_ROWS) {
+        row -= STATISTIC_ROWS +1;
+        if( row % 2 == 0) {
+            Module *module = moduleManager.getProfiler()->getProfile( row / 2)->module;
+            return module ? module->getMenuName() : "";
+        }
+        return "";
+    }
+#endif
+
+#ifdef ENABLE_LATENCY_STATISTICS
+    if( row == LATENCY_ROW) {
+        return TEXT_STATISTIC_LATENCY;
+    } else if( row == LATENCY_ROW +1) {
+        return "";
+    } else if( row > LATENCY_ROW +1) {
+        return latencyBucketNames[row - LATENCY_ROW -2];
+    }
+#endif
+
     return statisticNames[row];
 }
 
 uint8_t Statistics::getColCount( uint8_t row) {
 
+#ifdef ENABLE_MODULE_PROFILER
+    if( row == STATISTIC_ROWS) {
+        return 0;
+    } else if( row > STATISTIC_ROWS) {
+        return ((row - STATISTIC_ROWS -1) % 2 == 0) ? 0 : 3;
+    }
+#endif
+
+#ifdef ENABLE_LATENCY_STATISTICS
+    if( row == LATENCY_ROW) {
+        return 0;
+    } else if( row == LATENCY_ROW +1) {
+        return 3;
+    }
+#endif
+
     return 1;
 }
 
+#ifdef ENABLE_MODULE_PROFILER
+static int16_t ticksToUsec( const ModuleProfiler *profiler, profileTicks_t t) {
+
+    uint32_t usec = t / profiler->getTicksPerUsec();
+
+    return usec > INT16_MAX ? INT16_MAX : (int16_t)usec;
+}
+#endif
+
+#ifdef ENABLE_LATENCY_STATISTICS
+static int16_t usecToTenthMsec( uint32_t usec) {
+
+    usec /= 100;
+
+    return usec > INT16_MAX ? INT16_MAX : (int16_t)usec;
+}
+#endif
+
 void Statistics::getValue( uint8_t row, uint8_t col, Cell *cell) {
 
+#ifdef ENABLE_MODULE_PROFILER
+    if( row > STATISTIC_ROWS) {
+        const ModuleProfiler *profiler = moduleManager.getProfiler();
+        uint8_t idx = (row - STATISTIC_ROWS -1) / 2;
+
+        if( col == 0) {
+            cell->setInt16( 0, ticksToUsec( profiler, profiler->getProfile( idx)->minTicks), 4, 0, 0);
+        } else if( col == 1) {
+            cell->setInt16( 4, ticksToUsec( profiler, profiler->getAvgTicks( idx)), 4, 0, 0);
+        } else {
+            cell->setInt16( 8, ticksToUsec( profiler, profiler->getProfile( idx)->maxTicks), 5, 0, 0);
+        }
+        return;
+    }
+#endif
+
+#ifdef ENABLE_LATENCY_STATISTICS
+    if( row == LATENCY_ROW +1) {
+        /* min, avg, max in 0.1 msec */
+        if( col == 0) {
+            cell->setInt16( 0, usecToTenthMsec( latencyMin_usec), 4, 0, 0);
+        } else if( col == 1) {
+            cell->setInt16( 4, usecToTenthMsec( getAvgLatency()), 4, 0, 0);
+        } else {
+            cell->setInt16( 8, usecToTenthMsec( latencyMax_usec), 5, 0, 0);
+        }
+        return;
+    } else if( row > LATENCY_ROW +1) {
+        cell->setInt32( 7, latencyHist[row - LATENCY_ROW -2], 0, 0, 0);
+        return;
+    }
+#endif
+
     if( row == 0) {
         cell->setBool( 10, dumpTiming);
     } else if( row == 1) {
@@ -149,9 +342,13 @@ void Statistics::getValue( uint8_t row, uint8_t col, Cell *cell) {
     } else if( row == 5) {
         cell->setInt16( 7, maxFrameTime, 0, 0, 0);
     } else if( row == 6) {
-        cell->setInt16( 7, wdTimeout, 0, 0, 0);
+        cell->setInt16( 7, minFrameTime, 0, 0, 0);
     } else if( row == 7) {
+        cell->setInt16( 7, wdTimeout, 0, 0, 0);
+    } else if( row == 8) {
         cell->setInt16( 7, (int16_t)memfree, 0, 0, 0);
+    } else if( row == 9) {
+        cell->setInt16( 7, modulesRun, 0, 0, 0);
     }
 }
 
@@ -29,6 +29,14 @@
 
 #include "Module.h"
 
+#ifdef ENABLE_LATENCY_STATISTICS
+/* Stick to pulse latency histogram: LATENCY_BUCKETS buckets of
+ * LATENCY_BUCKET_usec each. The last bucket collects everything above.
+ */
+#define LATENCY_BUCKETS       8
+#define LATENCY_BUCKET_usec   4000
+#endif
+
 class Statistics : public Module {
 
     NO_CONFIG()
@@ -36,11 +44,21 @@ class Statistics : public Module {
     private:
         uint16_t timeUI_msec;
         uint16_t timeModules_msec;
+        uint8_t modulesRun;
         uint16_t ppmOverrun;
         uint16_t wdTimeout;
         timingUsec_t maxFrameTime;
+        timingUsec_t minFrameTime;
         size_t memfree;
 
+#ifdef ENABLE_LATENCY_STATISTICS
+        uint32_t latencyMin_usec;
+        uint32_t latencyMax_usec;
+        uint32_t latencySum_usec;
+        uint16_t latencyCount;
+        uint16_t latencyHist[LATENCY_BUCKETS];
+#endif
+
         bool dumpTiming;
         bool dumpOverrun;
 
@@ -49,10 +67,16 @@ class Statistics : public Module {
 
         void updateUITime( uint16_t t);
         void updateModulesTime( uint16_t t);
+        void updateModulesRun( uint8_t c);
         void updatePPMOverrun( uint16_t c);
-        void updateFrameTime( timingUsec_t t);
+        void updateFrameTime( timingUsec_t minT, timingUsec_t maxT);
         void updateWdTimeout( uint16_t t);
         void updateMemFree( size_t m);
+#ifdef ENABLE_LATENCY_STATISTICS
+        void updateLatency( uint32_t usec);
+        uint32_t getAvgLatency() const;
+        void exportLatency( ImportExport *exporter) const;
+#endif
 
         bool debugTiming() const;
         bool debugOverrun() const;
@@ -58,22 +58,34 @@ void SwitchedChannels::run( Controls &controls) {
 
     channel_t ch;
     switchState_t state;
+    channelValue_t *input = controls.inputChannels();
 
     for( channel_t sc = 0; sc < SWITCHED_CHANNELS; sc++) {
         if( IS_SWITCH_USED( CFG->sw[sc])) {
             ch = ANALOG_CHANNELS - SWITCHED_CHANNELS +sc;
             state = controls.switchGet( CFG->sw[sc]);
             if( state == 0) {
-                controls.inputSet( ch, PCT_TO_CHANNEL( CFG->state0_pct[sc]));
+                input[ch] = Controls::limit( PCT_TO_CHANNEL( CFG->state0_pct[sc]));
             } else if( state == 1) {
-                controls.inputSet( ch, PCT_TO_CHANNEL( CFG->state1_pct[sc]));
+                input[ch] = Controls::limit( PCT_TO_CHANNEL( CFG->state1_pct[sc]));
             } else {
-                controls.inputSet( ch, PCT_TO_CHANNEL( CFG->state2_pct[sc]));
+                input[ch] = Controls::limit( PCT_TO_CHANNEL( CFG->state2_pct[sc]));
             }
         }
     }
 }
 
+bool SwitchedChannels::checkActive() {
+
+    for( channel_t sc = 0; sc < SWITCHED_CHANNELS; sc++) {
+        if( IS_SWITCH_USED( CFG->sw[sc])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void SwitchedChannels::setDefaults() {
 
     INIT_NON_PHASED_CONFIGURATION(
@@ -161,4 +173,6 @@ void SwitchedChannels::setValue( uint8_t row, uint8_t col, Cell *cell) {
             CFG->state2_pct[ch] = cell->getInt8();
         }
     }
+
+    updateActive();
 }
@@ -51,6 +51,10 @@ class SwitchedChannels : public Module {
 
     NON_PHASED_CONFIG( switchedChannels_t)
 
+    protected:
+        /* From Module */
+        bool checkActive() final;
+
     public:
         SwitchedChannels();
 
@@ -25,35 +25,66 @@
 */
 
 /*
-    Interface code to the actual implementation of PPM generation.
+    Interface code to the actual implementation of PPM generation
+    or serial output (HF_SBUS on Arduino hardware).
+    The emulation always uses its OutputImpl to display the channels.
  */
 
 #include "Output.h"
+
+#if HF_MODULE == HF_SBUS && defined( ARDUINO )
+#include "SerialOutput.h"
+
+extern SerialOutput *serialOutput;
+#define OUTPUT_BACKEND serialOutput
+#else
 #include "OutputImpl.h"
 
 extern OutputImpl *outputImpl;
+#define OUTPUT_BACKEND outputImpl
+#endif
 
 Output::Output() = default;
 
 /* Returns true if the PPM generator is ready to accept the next channel set */
 bool Output::acceptChannels() const {
   
-  return outputImpl->acceptChannels();  
+  return OUTPUT_BACKEND->acceptChannels();  
 }
 
 void Output::setChannels( Controls &controls) const {
 
-    for( channel_t ch = 0; ch<PPM_CHANNELS; ch++) {
-        outputImpl->SetChannelValue( ch, controls.outputGet(ch));
-    }
+#ifdef ENABLE_LATENCY_STATISTICS
+    OUTPUT_BACKEND->SetInputTime( controls.getInputTime());
+#endif
+    OUTPUT_BACKEND->SetChannelValues( controls.outputChannels());
 }
 
 uint16_t Output::getOverrunCounter() {
 
-    return outputImpl->getOverrunCounter();
+    return OUTPUT_BACKEND->getOverrunCounter();
 }
 
 timingUsec_t Output::getMaxFrameTime() {
 
-    return outputImpl->getMaxFrameTime();
+    return OUTPUT_BACKEND->getMaxFrameTime();
+}
+
+timingUsec_t Output::getMinFrameTime() {
+
+    return OUTPUT_BACKEND->getMinFrameTime();
+}
+
+#ifdef ENABLE_LATENCY_STATISTICS
+bool Output::getLatency( uint32_t &usec) {
+
+    return OUTPUT_BACKEND->getLatency( usec);
+}
+#endif
+
+#ifdef ENABLE_JIT_SCHEDULING
+unsigned long Output::getNextSwitchTime() {
+
+    return OUTPUT_BACKEND->getNextSwitchTime();
 }
+#endif
@@ -45,6 +45,19 @@ class Output {
 
         uint16_t getOverrunCounter();
         timingUsec_t getMaxFrameTime();
+        timingUsec_t getMinFrameTime();
+
+#ifdef ENABLE_LATENCY_STATISTICS
+        /* Returns true and the age of the input of the last frame
+         * sent, once per frame.
+         */
+        bool getLatency( uint32_t &usec);
+#endif
+
+#ifdef ENABLE_JIT_SCHEDULING
+        /* micros() when the next frame starts */
+        unsigned long getNextSwitchTime();
+#endif
 };
 
 #endif
@@ -0,0 +1,169 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "SerialOutput.h"
+
+#define OTHER_SET( s)    ((s) ^ 1)
+
+SerialOutput::SerialOutput( Stream &s) : stream( s) {
+
+    encodeFrame( frame[0], NULL, 0);
+    encodeFrame( frame[1], NULL, 0);
+
+    currentSet = 0;
+    channelSetDone = false;
+    overrun = 0;
+#ifdef ENABLE_LATENCY_STATISTICS
+    inputTime_usec[0] = inputTime_usec[1] = micros();
+    latencyValid = false;
+#endif
+
+    nextFrame_usec = micros();
+    lastFrame_usec = nextFrame_usec - OUTPUT_FRAME_TIME_usec;
+    maxFrameTime_usec = 0;
+    minFrameTime_usec = 0;
+}
+
+bool SerialOutput::acceptChannels() {
+
+    unsigned long now = micros();
+
+    if( (long)(now - nextFrame_usec) >= 0) {
+        sendFrame( now);
+    }
+
+    return !channelSetDone;
+}
+
+/* Switch to the last computed frame and start transmission.
+ * Increase the overrun counter if no new frame was computed in time.
+ */
+void SerialOutput::sendFrame( unsigned long now) {
+
+    timingUsec_t t;
+
+    if( channelSetDone) {
+        channelSetDone = false;
+        currentSet = OTHER_SET( currentSet);
+#ifdef ENABLE_LATENCY_STATISTICS
+        latency_usec = now - inputTime_usec[currentSet];
+        latencyValid = true;
+#endif
+    } else {
+        overrun++;
+    }
+
+    stream.write( frame[currentSet], SBUS_FRAME_SIZE);
+
+    t = (timingUsec_t)(now - lastFrame_usec);
+    if( t > maxFrameTime_usec) {
+        maxFrameTime_usec = t;
+    }
+    if( minFrameTime_usec == 0 || t < minFrameTime_usec) {
+        minFrameTime_usec = t;
+    }
+    lastFrame_usec = now;
+
+    nextFrame_usec += OUTPUT_FRAME_TIME_usec;
+
+    /* Lost more than one frame. Do not try to catch up. */
+    if( (long)(now - nextFrame_usec) >= 0) {
+        nextFrame_usec = now + OUTPUT_FRAME_TIME_usec;
+    }
+}
+
+/* Encode all channels into the frame that is sent next
+ * and set the channelSetDone flag.
+ * Does nothing if the last frame has not been sent yet.
+ */
+void SerialOutput::SetChannelValues( const channelValue_t values[]) {
+
+    if( !channelSetDone) {
+        encodeFrame( frame[OTHER_SET( currentSet)], values, PPM_CHANNELS);
+        channelSetDone = true;
+    }
+}
+
+#ifdef ENABLE_LATENCY_STATISTICS
+void SerialOutput::SetInputTime( unsigned long t) {
+
+    if( !channelSetDone) {
+        inputTime_usec[OTHER_SET( currentSet)] = t;
+    }
+}
+
+bool SerialOutput::getLatency( uint32_t &usec) {
+
+    bool valid = latencyValid;
+
+    usec = latency_usec;
+    latencyValid = false;
+
+    return valid;
+}
+#endif
+
+/* Convert with the same timing as PPM:
+ *
+ * value                              SBUS
+ * =======                            ====
+ * CHANNELVALUE_MID   0               992   (1500 usec)
+ * CHANNELVALUE_MIN   -1000 == -100%  352   (1100 usec)
+ * CHANNELVALUE_MAX    1000 ==  100%  1632  (1900 usec)
+ */
+void SerialOutput::encodeFrame( uint8_t *frame, const channelValue_t values[], channel_t count) {
+
+    uint32_t bits = 0;
+    uint8_t bitCount = 0;
+    int16_t v;
+    uint8_t *p = frame;
+
+    *p++ = SBUS_HEADER;
+
+    for( channel_t ch = 0; ch < SBUS_CHANNELS; ch++) {
+
+        v = SBUS_MID;
+
+        if( ch < count) {
+            v += (int16_t)(values[ch] * 16 / 25);
+
+            if( v < SBUS_MIN) v = SBUS_MIN;
+            if( v > SBUS_MAX) v = SBUS_MAX;
+        }
+
+        bits |= (uint32_t)v << bitCount;
+        bitCount += 11;
+
+        while( bitCount >= 8) {
+            *p++ = (uint8_t)bits;
+            bits >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    *p++ = 0;   // Flags
+    *p = SBUS_FOOTER;
+}
@@ -0,0 +1,115 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/*
+    Serial output for HF modules with a digital input.
+
+    The channels are packed into an SBUS frame:
+
+    Byte   0      Header 0x0F
+    Byte   1-22   16 channels, 11 bits each, LSB first
+    Byte  23      Flags (frame lost, failsafe, ch17, ch18)
+    Byte  24      Footer 0x00
+
+    The frame is sent with 100000 baud 8E2. The signal is inverted.
+    A frame is sent every SERIAL_FRAME_TIME_usec. The next frame is computed
+    while the current one is transmitted. Transmission is done by the
+    interrupt driven UART of the Stream.
+
+    The interface is the same as OutputImpl.
+ */
+
+#ifndef _SerialOutput_h_
+#define _SerialOutput_h_
+
+#include "TXos.h"
+#include "Controls.h"
+
+#define SBUS_CHANNELS         ((channel_t)16)
+#define SBUS_FRAME_SIZE       25
+
+#define SBUS_HEADER           ((uint8_t)0x0f)
+#define SBUS_FOOTER           ((uint8_t)0x00)
+
+/* 1500 usec. One SBUS step is 0.625 usec. */
+#define SBUS_MID              992
+/* 150%   1500 +/- 600 usec */
+#define SBUS_MIN              (SBUS_MID - 960)
+#define SBUS_MAX              (SBUS_MID + 960)
+
+class SerialOutput {
+
+    private:
+        Stream &stream;
+
+        uint8_t frame[2][SBUS_FRAME_SIZE];
+        uint8_t currentSet;
+
+        bool channelSetDone;
+
+#ifdef ENABLE_LATENCY_STATISTICS
+        unsigned long inputTime_usec[2];
+        uint32_t latency_usec;
+        bool latencyValid;
+#endif
+        uint16_t overrun;
+
+        unsigned long nextFrame_usec;
+        unsigned long lastFrame_usec;
+        timingUsec_t maxFrameTime_usec;
+        timingUsec_t minFrameTime_usec;
+
+        void sendFrame( unsigned long now);
+
+    public:
+        explicit SerialOutput( Stream &s);
+
+        /* Returns true if the next channel set can be computed.
+         * Sends the last computed frame when it is due.
+         */
+        bool acceptChannels();
+        bool isChannelSetDone() const { return channelSetDone; }
+        void SetChannelValues( const channelValue_t values[]);
+
+#ifdef ENABLE_LATENCY_STATISTICS
+        void SetInputTime( unsigned long t);
+        bool getLatency( uint32_t &usec);
+#endif
+#ifdef ENABLE_JIT_SCHEDULING
+        unsigned long getNextSwitchTime() const { return nextFrame_usec; }
+#endif
+
+        uint16_t getOverrunCounter() const { return overrun; }
+        timingUsec_t getMaxFrameTime() const { return maxFrameTime_usec; }
+        timingUsec_t getMinFrameTime() const { return minFrameTime_usec; }
+
+        /* Pack count channel values into frame.
+         * Missing channels are set to mid.
+         */
+        static void encodeFrame( uint8_t *frame, const channelValue_t values[], channel_t count);
+};
+
+#endif
@@ -40,11 +40,34 @@
 #include "AssignInput.h"
 #include "ChannelDelay.h"
 
+#include "Model.h"
+#include "Mixer.h"
+#include "PhasesTrim.h"
+#include "MixProgram.h"
+
+#include "ServoRemap.h"
+#include "ServoReverse.h"
+#include "ServoSubtrim.h"
+#include "ServoTest.h"
+#include "ServoLimit.h"
+#include "OutputProgram.h"
+
+#include "SerialOutput.h"
+#include "LoopbackStream.h"
+
 #include "UtModules.h"
 
 extern InputImpl *inputImpl;
 extern Controls controls;
 extern ModuleManager moduleManager;
+extern unsigned long unittestMicros;
+
+#ifdef ENABLE_MIX_PROGRAM
+extern MixProgram mixProgram;
+#endif
+#ifdef ENABLE_OUTPUT_PROGRAM
+extern OutputProgram outputProgram;
+#endif
 
 CalibrateSticks calibrateSticks;
 CalibrateTrim calibrateTrim;
@@ -57,6 +80,16 @@ ChannelReverse channelReverse;
 AssignInput assignInput;
 ChannelDelay channelDelay;
 
+Model model;
+Mixer mixer;
+PhasesTrim phasesTrim;
+
+ServoRemap servoRemap;
+ServoReverse servoReverse;
+ServoSubtrim servoSubtrim;
+ServoTest servoTest;
+ServoLimit servoLimit;
+
 DECLARE_ASSERT_COUNTER
 
 void UtModules::run() {
@@ -65,6 +98,9 @@ void UtModules::run() {
 
     controls.init();
 
+    /* Modules look up the input assignment in the model set */
+    moduleManager.addToModelSetAndMenu( &assignInput);
+
     UtCalibrateSticks();
     UtCalibrateTrim();
     UtAnalogTrim();
@@ -81,12 +117,16 @@ void UtModules::run() {
     // UtModel
     // UtMixer
     // UtPhasesTrim
+    UtMixProgram();
     // UtEngineCut
 
     // UtServoRemap
     // UtServoReverse
     // UtServoSubtrim
     // UtServoLimit
+    UtOutputProgram();
+
+    UtSerialOutput();
 
     // dumpControls( controls);
 
@@ -115,11 +155,18 @@ void UtModules::UtCalibrateSticks() {
         calibrateSticksCFG->maxPos[ch] = 700;
     }
 
+    /* Recompute scale factors */
+    calibrateSticks.init();
+
     moduleManager.addToRunList( &calibrateSticks);
 
     verify( 0, PORT_ANALOG_INPUT_COUNT, 300, -1250);
     verify( 0, PORT_ANALOG_INPUT_COUNT, 500, 0);
     verify( 0, PORT_ANALOG_INPUT_COUNT, 700, 1250);
+
+    /* Results are truncated towards zero */
+    verify( 0, PORT_ANALOG_INPUT_COUNT, 349, -943);
+    verify( 0, PORT_ANALOG_INPUT_COUNT, 651, 943);
 }
 
 void UtModules::UtCalibrateTrim() {
@@ -142,6 +189,9 @@ void UtModules::UtCalibrateTrim() {
         calibrateTrimCFG->maxPos[ch] = 700;
     }
 
+    /* Recompute scale factors */
+    calibrateTrim.init();
+
     moduleManager.addToRunList( &calibrateTrim);
 }
 
@@ -314,18 +364,21 @@ void UtModules::UtChannelRange() {
     verify( 0, PORT_ANALOG_INPUT_COUNT, 700, 1000);
 
     /* Unlimit to 125% */
-    channelRangeCFG->range_pct[0] = 125;
+    channelRangeCFG->posRange_pct[0] = 125;
+    channelRangeCFG->negRange_pct[0] = 125;
     verify( 0, 1, 300, -1250);
     verify( 0, 1, 700, 1250);
 
     /* Limit to 50% */
-    channelRangeCFG->range_pct[0] = 50;
+    channelRangeCFG->posRange_pct[0] = 50;
+    channelRangeCFG->negRange_pct[0] = 50;
     verify( 0, 1, 300, -500);
     verify( 0, 1, 700, 500);
 
     /* Reset to +/- 100% */
     std::cout << "Reset channel range to +/- 100%" << std::endl;
-    channelRangeCFG->range_pct[0] = 100;
+    channelRangeCFG->posRange_pct[0] = 100;
+    channelRangeCFG->negRange_pct[0] = 100;
 }
 
 void UtModules::UtChannelReverse() {
@@ -408,6 +461,21 @@ void UtModules::UtAssignInput() {
     assignInput.setDefaults();
 }
 
+/* Run ChannelDelay for a number of frames with logical channel 0 set to target.
+ * The clock advances by frame_usec per frame.
+ * Returns the delayed value of channel 0.
+ */
+static channelValue_t runDelay( uint16_t frames, channelValue_t target, unsigned long frame_usec = OUTPUT_FRAME_TIME_usec) {
+
+    for( uint16_t f = 0; f < frames; f++) {
+        unittestMicros += frame_usec;
+        controls.logicalSet( 0, target);
+        channelDelay.run( controls);
+    }
+
+    return controls.logicalGet( 0);
+}
+
 void UtModules::UtChannelDelay() {
 
     std::cout << std::endl << "*** Module: ChannelDelay" << std::endl;
@@ -418,8 +486,340 @@ void UtModules::UtChannelDelay() {
     ASSERT_UINT8_T( channelDelay.getConfigType(), MODULE_CHANNEL_DELAY_TYPE , "channelDelay.getConfigType()");
     ASSERT_UINT8_T( channelDelay.getRowCount(), MIX_CHANNELS, "channelDelay.getRowCount()");
 
-    // channelDelay_t *channelDelayCFG = (channelDelay_t*)channelDelay.getConfig();
+    channelDelay_t *channelDelayCFG = (channelDelay_t*)channelDelay.getConfig();
     moduleManager.addToRunList( &channelDelay);
+
+    /* Nominal frame time and the limits of adaptive PPM */
+    const unsigned long frameTimes_usec[] = { OUTPUT_FRAME_TIME_usec, 12100, 22900 };
+
+    unittestMicros = 1;
+
+    std::cout << "Delay 10.0 sec, up only" << std::endl;
+
+    channelDelayCFG->posDelay_sec[0] = 100;
+    channelDelay.init();
+    channelDelay.updateActive();
+    ASSERT_UINT8_T( channelDelay.isActive(), true, "delay active");
+
+    for( unsigned long frame_usec : frameTimes_usec) {
+
+        std::cout << "Frame time " << frame_usec << " usec" << std::endl;
+
+        /* Frames for 10 sec. Steps are truncated, allow 1% more. */
+        uint16_t frames = (uint16_t)(10000000L / frame_usec);
+        uint16_t tolerance = frames / 100 +1;
+
+        ASSERT_INT16_T( runDelay( 1, CHANNELVALUE_MIN, frame_usec), CHANNELVALUE_MIN, "move down undelayed");
+        ASSERT_UINT8_T( runDelay( frames - tolerance, CHANNELVALUE_MAX, frame_usec) < CHANNELVALUE_MAX, true, "not at max before 10 sec");
+        ASSERT_INT16_T( runDelay( 2 * tolerance, CHANNELVALUE_MAX, frame_usec), CHANNELVALUE_MAX, "at max after 10 sec");
+        ASSERT_INT16_T( runDelay( 1, CHANNELVALUE_MIN, frame_usec), CHANNELVALUE_MIN, "move down undelayed");
+    }
+
+    std::cout << "Resync after delay off and on" << std::endl;
+
+    channelDelayCFG->posDelay_sec[0] = 0;
+    channelDelay.init();
+    channelDelay.updateActive();
+    ASSERT_UINT8_T( channelDelay.isActive(), false, "delay inactive");
+
+    /* Not run while inactive. The stick moves to max meanwhile. */
+    channelDelayCFG->posDelay_sec[0] = 100;
+    channelDelay.init();
+    channelDelay.updateActive();
+    ASSERT_INT16_T( runDelay( 1, CHANNELVALUE_MAX), CHANNELVALUE_MAX, "start from current position");
+
+    /* set back to default */
+    channelDelay.setDefaults();
+    channelDelay.updateActive();
+    unittestMicros = 0;
+}
+
+/* Run a sequence of modules like the module pipeline.
+ * The tests change configurations directly, so the compiled
+ * programs are rebuilt and the active state is recomputed.
+ */
+static void runStage( Module *const stage[], uint8_t count) {
+
+#ifdef ENABLE_MIX_PROGRAM
+    mixProgram.invalidate();
+#endif
+#ifdef ENABLE_OUTPUT_PROGRAM
+    outputProgram.invalidate();
+#endif
+
+    for( uint8_t i = 0; i < count; i++) {
+        stage[i]->updateActive();
+        if( stage[i]->isActive()) {
+            stage[i]->run( controls);
+        }
+    }
+}
+
+/* Model, Mixer and PhasesTrim give the same results
+ * with and without ENABLE_MIX_PROGRAM.
+ */
+void UtModules::UtMixProgram() {
+
+    std::cout << std::endl << "*** Module: Model, Mixer, PhasesTrim" << std::endl;
+
+    Module *const stage[] = { &model, &mixer, &phasesTrim };
+
+    model.setDefaults();
+    mixer.setDefaults();
+    phasesTrim.setDefaults();
+
+    moduleManager.addToModelSetAndMenu( &model);
+    moduleManager.addToModelSetAndMenu( &mixer);
+    moduleManager.addToModelSetAndMenu( &phasesTrim);
+
+    mixer_t *mixerCFG = (mixer_t*)mixer.getConfig();
+    phasesTrim_t *phasesTrimCFG = (phasesTrim_t*)phasesTrim.getConfig();
+
+    /* Mix 50% of elevator with 10% offset into aileron, switch 0 in state 1 */
+    SET_SWITCH( mixerCFG->mixSw[0], 0);
+    SET_SWITCH_STATE( mixerCFG->mixSw[0], SW_STATE_1);
+    SET_SWITCH_USED( mixerCFG->mixSw[0]);
+    mixerCFG->source[0] = CHANNEL_ELEVATOR;
+    mixerCFG->target[0] = CHANNEL_AILERON;
+    mixerCFG->mixPct[0] = 50;
+    mixerCFG->mixOffset[0] = 10;
+
+    /* Trim aileron +5% and flap -10% in phase 0 */
+    phasesTrimCFG->trim_pct[0] = 5;
+    phasesTrimCFG->trim_pct[2] = -10;
+
+    controls.switchSet( 0, SW_STATE_1);
+    controls.logicalSet( CHANNEL_AILERON, 300);
+    controls.logicalSet( CHANNEL_ELEVATOR, 500);
+    controls.logicalSet( CHANNEL_FLAP, 200);
+    runStage( stage, 3);
+
+    /* (500 - 100) * 50% = 200 */
+    ASSERT_INT16_T( controls.logicalGet( CHANNEL_AILERON), 300 + 200 + 50, "aileron mixed and trimmed");
+    ASSERT_INT16_T( controls.logicalGet( CHANNEL_AILERON2), -300 - 200 + 50, "aileron2 mixed and trimmed");
+    ASSERT_INT16_T( controls.logicalGet( CHANNEL_ELEVATOR), 500, "elevator unchanged");
+    ASSERT_INT16_T( controls.logicalGet( CHANNEL_FLAP), 200 - 100, "flap trimmed");
+    ASSERT_INT16_T( controls.logicalGet( CHANNEL_FLAP2), 200 - 100, "flap2 trimmed");
+
+    /* Each step is limited to +/- 125% */
+    controls.logicalSet( CHANNEL_AILERON, 1200);
+    runStage( stage, 3);
+
+    ASSERT_INT16_T( controls.logicalGet( CHANNEL_AILERON), CHANNELVALUE_MAX_LIMIT, "aileron limited");
+    ASSERT_INT16_T( controls.logicalGet( CHANNEL_AILERON2), CHANNELVALUE_MIN_LIMIT + 50, "aileron2 limited, then trimmed");
+
+    /* Mix switched off */
+    controls.switchSet( 0, SW_STATE_0);
+    controls.logicalSet( CHANNEL_AILERON, 300);
+    runStage( stage, 3);
+
+    ASSERT_INT16_T( controls.logicalGet( CHANNEL_AILERON), 300 + 50, "mix off");
+    ASSERT_INT16_T( controls.logicalGet( CHANNEL_AILERON2), -300 + 50, "mix off");
+
+    /* set back to default */
+    model.setDefaults();
+    mixer.setDefaults();
+    phasesTrim.setDefaults();
+}
+
+/* ServoRemap, ServoReverse, ServoSubtrim, ServoTest and ServoLimit
+ * give the same results with and without ENABLE_OUTPUT_PROGRAM.
+ */
+void UtModules::UtOutputProgram() {
+
+    std::cout << std::endl << "*** Module: ServoRemap, ServoReverse, ServoSubtrim, ServoTest, ServoLimit" << std::endl;
+
+    Module *const stage[] = { &servoRemap, &servoReverse, &servoSubtrim, &servoTest, &servoLimit };
+
+    servoRemap.setDefaults();
+    servoReverse.setDefaults();
+    servoSubtrim.setDefaults();
+    servoTest.setDefaults();
+    servoLimit.setDefaults();
+
+    moduleManager.addToModelSetAndMenu( &servoRemap);
+    moduleManager.addToModelSetAndMenu( &servoReverse);
+    moduleManager.addToModelSetAndMenu( &servoSubtrim);
+    moduleManager.addToModelSetAndMenu( &servoLimit);
+
+#ifdef ENABLE_OUTPUT_PROGRAM
+    outputProgram.setOverride( &servoTest);
+#endif
+
+    servoRemap_t *servoRemapCFG = (servoRemap_t*)servoRemap.getConfig();
+    servoReverse_t *servoReverseCFG = (servoReverse_t*)servoReverse.getConfig();
+    servoSubtrim_t *servoSubtrimCFG = (servoSubtrim_t*)servoSubtrim.getConfig();
+    servoLimit_t *servoLimitCFG = (servoLimit_t*)servoLimit.getConfig();
+
+    /* Servo 1: reversed, +10% subtrim, limits -40% / 80% */
+    servoRemapCFG->source[1] = CHANNEL_AILERON;
+    servoReverseCFG->revBits |= 1 << 1;
+    servoSubtrimCFG->trim_pct[1] = 10;
+    servoLimitCFG->negLimit_pct[1] = -40;
+    servoLimitCFG->posLimit_pct[1] = 80;
+
+    /* Servo 2: -20% subtrim, crossed limits. The negative limit wins. */
+    servoRemapCFG->source[2] = CHANNEL_AILERON;
+    servoSubtrimCFG->trim_pct[2] = -20;
+    servoLimitCFG->negLimit_pct[2] = 30;
+    servoLimitCFG->posLimit_pct[2] = 10;
+
+    /* Servo 3: unassigned, reversed, +5% subtrim */
+    servoRemapCFG->source[3] = LOGICAL_CHANNELS;
+    servoReverseCFG->revBits |= 1 << 3;
+    servoSubtrimCFG->trim_pct[3] = 5;
+
+    controls.logicalSet( CHANNEL_AILERON, 200);
+    runStage( stage, 5);
+
+    ASSERT_INT16_T( controls.outputGet( 1), -200 + 100, "reverse and subtrim");
+    ASSERT_INT16_T( controls.outputGet( 2), 300, "crossed limits");
+    ASSERT_INT16_T( controls.outputGet( 3), 50, "unassigned source");
+
+    controls.logicalSet( CHANNEL_AILERON, 1000);
+    runStage( stage, 5);
+
+    ASSERT_INT16_T( controls.outputGet( 1), -400, "negative limit");
+    ASSERT_INT16_T( controls.outputGet( 2), 300, "crossed limits");
+
+    controls.logicalSet( CHANNEL_AILERON, -1000);
+    runStage( stage, 5);
+
+    ASSERT_INT16_T( controls.outputGet( 1), 800, "positive limit");
+    ASSERT_INT16_T( controls.outputGet( 2), 300, "crossed limits");
+    ASSERT_INT16_T( controls.outputGet( 3), 50, "unassigned source");
+
+    std::cout << "ServoTest +100%" << std::endl;
+
+    servoTest.setTest( SERVOTEST_MAX);
+    ASSERT_UINT8_T( servoTest.isTesting(), true, "servo test running");
+
+    /* Moves 1% per frame */
+    for( uint8_t f = 0; f < 250; f++) {
+        runStage( stage, 5);
+    }
+
+    ASSERT_INT16_T( controls.outputGet( 1), 800, "test obeys positive limit");
+    ASSERT_INT16_T( controls.outputGet( 2), 300, "test obeys crossed limits");
+    ASSERT_INT16_T( controls.outputGet( 3), CHANNELVALUE_MAX, "test on unassigned source");
+
+    servoTest.setTest( SERVOTEST_OFF);
+    ASSERT_UINT8_T( servoTest.isTesting(), false, "servo test off");
+    runStage( stage, 5);
+
+    ASSERT_INT16_T( controls.outputGet( 1), 800, "back to channel value");
+    ASSERT_INT16_T( controls.outputGet( 3), 50, "back to channel value");
+
+    /* set back to default */
+    servoRemap.setDefaults();
+    servoReverse.setDefaults();
+    servoSubtrim.setDefaults();
+    servoLimit.setDefaults();
+}
+
+/* Extract channel ch from an SBUS frame */
+static uint16_t sbusChannel( const uint8_t *frame, channel_t ch) {
+
+    uint16_t bit = ch * 11;
+    const uint8_t *p = frame + 1 + bit / 8;
+    uint32_t v = p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+
+    return (uint16_t)((v >> (bit % 8)) & 0x7ff);
+}
+
+void UtModules::UtSerialOutput() {
+
+    std::cout << std::endl << "*** Output: SerialOutput" << std::endl;
+
+    uint8_t frame[SBUS_FRAME_SIZE];
+    channelValue_t values[SBUS_CHANNELS];
+    LoopbackStream stream;
+
+    values[0] = CHANNELVALUE_MID;
+    values[1] = CHANNELVALUE_MIN;
+    values[2] = CHANNELVALUE_MAX;
+    values[3] = 2 * CHANNELVALUE_MAX;
+    values[4] = 2 * CHANNELVALUE_MIN;
+
+    /* 5 channels given, the rest is set to mid */
+    SerialOutput::encodeFrame( frame, values, 5);
+
+    ASSERT_UINT8_T( frame[0], SBUS_HEADER, "SBUS header");
+
+    /* 992, 352 and 1632 packed 11 bit LSB first */
+    ASSERT_UINT8_T( frame[1], 0xe0, "SBUS byte 1");
+    ASSERT_UINT8_T( frame[2], 0x03, "SBUS byte 2");
+    ASSERT_UINT8_T( frame[3], 0x0b, "SBUS byte 3");
+    ASSERT_UINT8_T( frame[4], 0x98, "SBUS byte 4");
+
+    ASSERT_UINT16_T( sbusChannel( frame, 0), 992, "SBUS mid");
+    ASSERT_UINT16_T( sbusChannel( frame, 1), 352, "SBUS -100%");
+    ASSERT_UINT16_T( sbusChannel( frame, 2), 1632, "SBUS 100%");
+    ASSERT_UINT16_T( sbusChannel( frame, 3), SBUS_MAX, "SBUS clamped to max");
+    ASSERT_UINT16_T( sbusChannel( frame, 4), SBUS_MIN, "SBUS clamped to min");
+
+    for( channel_t ch = 5; ch < SBUS_CHANNELS; ch++) {
+        ASSERT_UINT16_T( sbusChannel( frame, ch), SBUS_MID, "SBUS channel beyond count");
+    }
+
+    ASSERT_UINT8_T( frame[SBUS_FRAME_SIZE -2], 0, "SBUS flags");
+    ASSERT_UINT8_T( frame[SBUS_FRAME_SIZE -1], SBUS_FOOTER, "SBUS footer");
+
+    std::cout << "Frame pacing" << std::endl;
+
+    unittestMicros = 1000000;
+
+    SerialOutput serialOutput( stream);
+
+    /* The first frame is due at once. Nothing computed yet. */
+    ASSERT_UINT8_T( serialOutput.acceptChannels(), true, "accept first set");
+    ASSERT_UINT16_T( stream.getLength(), SBUS_FRAME_SIZE, "first frame sent");
+    ASSERT_UINT16_T( serialOutput.getOverrunCounter(), 1, "first frame overrun");
+    ASSERT_UINT16_T( sbusChannel( stream.getData(), 1), SBUS_MID, "first frame mid");
+
+    serialOutput.SetChannelValues( values);
+    ASSERT_UINT8_T( serialOutput.isChannelSetDone(), true, "set done");
+    ASSERT_UINT8_T( serialOutput.acceptChannels(), false, "wait for frame");
+
+    unittestMicros += OUTPUT_FRAME_TIME_usec -1;
+    ASSERT_UINT8_T( serialOutput.acceptChannels(), false, "frame not due");
+    ASSERT_UINT16_T( stream.getLength(), SBUS_FRAME_SIZE, "no early frame");
+
+    unittestMicros += 1;
+    ASSERT_UINT8_T( serialOutput.acceptChannels(), true, "frame due");
+    ASSERT_UINT16_T( stream.getLength(), 2 * SBUS_FRAME_SIZE, "second frame sent");
+    ASSERT_UINT16_T( serialOutput.getOverrunCounter(), 1, "no overrun");
+    ASSERT_UINT16_T( sbusChannel( stream.getData() + SBUS_FRAME_SIZE, 1), 352, "computed frame sent");
+    ASSERT_UINT16_T( serialOutput.getMinFrameTime(), OUTPUT_FRAME_TIME_usec, "min frame time");
+
+    std::cout << "Overrun" << std::endl;
+
+    /* No new set computed. The last frame is repeated. */
+    unittestMicros += OUTPUT_FRAME_TIME_usec;
+    serialOutput.acceptChannels();
+    ASSERT_UINT16_T( stream.getLength(), 3 * SBUS_FRAME_SIZE, "frame repeated");
+    ASSERT_UINT16_T( serialOutput.getOverrunCounter(), 2, "overrun counted");
+    ASSERT_UINT16_T( sbusChannel( stream.getData() + 2 * SBUS_FRAME_SIZE, 1), 352, "last frame repeated");
+
+    /* Two frame times late. One frame is sent, no catching up. */
+    serialOutput.SetChannelValues( values);
+    unittestMicros += 2 * OUTPUT_FRAME_TIME_usec;
+    serialOutput.acceptChannels();
+    serialOutput.acceptChannels();
+    ASSERT_UINT16_T( stream.getLength(), 4 * SBUS_FRAME_SIZE, "one frame after delay");
+    ASSERT_UINT16_T( serialOutput.getOverrunCounter(), 2, "late set not counted");
+    ASSERT_UINT16_T( serialOutput.getMaxFrameTime(), 2 * OUTPUT_FRAME_TIME_usec, "max frame time");
+
+    /* Next frame one frame time after the late one */
+    unittestMicros += OUTPUT_FRAME_TIME_usec -1;
+    serialOutput.acceptChannels();
+    ASSERT_UINT16_T( stream.getLength(), 4 * SBUS_FRAME_SIZE, "resync not due");
+
+    unittestMicros += 1;
+    serialOutput.acceptChannels();
+    ASSERT_UINT16_T( stream.getLength(), 5 * SBUS_FRAME_SIZE, "resync due");
+
+    unittestMicros = 0;
 }
 
 void UtModules::verify( channel_t start, uint8_t count, channelValue_t in, channelValue_t expected) {
@@ -442,9 +842,6 @@ void UtModules::dumpControls( Controls &controls) {
     for( uint8_t i = 0; i<PORT_ANALOG_INPUT_COUNT; i++) {
         printf("  adc stick[%d] %d\n", i, controls.stickADCGet(i));
     }
-    for( uint8_t i = 0; i<PORT_ANALOG_INPUT_COUNT; i++) {
-        printf("  adc range[%d] %d\n", i, controls.rangeGet(i));
-    }
     for( uint8_t i = 0; i<PORT_TRIM_INPUT_COUNT; i++) {
         printf("  adc trim[%d] %d\n", i, controls.trimADCGet(i));
     }
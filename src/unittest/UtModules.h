@@ -47,6 +47,11 @@ class UtModules : public UnitTest {
         void UtAssignInput();
         void UtChannelDelay();
 
+        void UtMixProgram();
+        void UtOutputProgram();
+
+        void UtSerialOutput();
+
         void verify( channel_t start, uint8_t count, channelValue_t in, channelValue_t expected);
         void dumpControls( Controls &controls);
 };
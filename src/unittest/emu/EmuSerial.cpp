@@ -37,24 +37,18 @@ void EmuSerial::send(const char* text) {
     // printf("EmuSerial: send: %s\n", text);
 
     while( *text) {
-        recvCriticalSection.Enter();
-
-        while( *text) {
-            if( recvInPtr < (recvOutPtr-1) 
-                || ((recvInPtr >= recvOutPtr) && ((recvInPtr != EMUSERIAL_BUFFER_SIZE-1) || (recvOutPtr != 0))))
-            {
-                recvBuffer[recvInPtr++] = *text;
-                text++;
-                if( recvInPtr >= EMUSERIAL_BUFFER_SIZE ) {
-                    recvInPtr = 0;
-                }
-            } else {
-                printf("EmuSerial: send buffer full\n");
-                break;
+        if( recvInPtr < (recvOutPtr-1) 
+            || ((recvInPtr >= recvOutPtr) && ((recvInPtr != EMUSERIAL_BUFFER_SIZE-1) || (recvOutPtr != 0))))
+        {
+            recvBuffer[recvInPtr++] = *text;
+            text++;
+            if( recvInPtr >= EMUSERIAL_BUFFER_SIZE ) {
+                recvInPtr = 0;
             }
+        } else {
+            printf("EmuSerial: send buffer full\n");
+            break;
         }
-
-        recvCriticalSection.Leave();
     }
 }
 
@@ -62,8 +56,6 @@ int EmuSerial::receive() {
 
     int ch = -1; 
 
-    sendCriticalSection.Enter();
-
     if( sendInPtr != sendOutPtr ) {
         ch = sendBuffer[sendOutPtr++];
         if( sendOutPtr >= EMUSERIAL_BUFFER_SIZE ) {
@@ -71,8 +63,6 @@ int EmuSerial::receive() {
         }
     }
 
-    sendCriticalSection.Leave();
-
     return ch;
 }
 
@@ -85,25 +75,19 @@ size_t EmuSerial::write(const char* text) {
     // printf("EmuSerial: write: %s\n", text);
 
     while( *text) {
-        sendCriticalSection.Enter();
-
-        while( *text) {
-            if( sendInPtr < (sendOutPtr-1) 
-                || ((sendInPtr >= sendOutPtr) && ((sendInPtr != EMUSERIAL_BUFFER_SIZE-1) || (sendOutPtr != 0))))
-            {
-                sendBuffer[sendInPtr++] = *text;
-                text++;
-                cnt++;
-                if( sendInPtr >= EMUSERIAL_BUFFER_SIZE ) {
-                    sendInPtr = 0;
-                }
-            } else {
-                printf("EmuSerial: write buffer full\n");
-                break;
+        if( sendInPtr < (sendOutPtr-1) 
+            || ((sendInPtr >= sendOutPtr) && ((sendInPtr != EMUSERIAL_BUFFER_SIZE-1) || (sendOutPtr != 0))))
+        {
+            sendBuffer[sendInPtr++] = *text;
+            text++;
+            cnt++;
+            if( sendInPtr >= EMUSERIAL_BUFFER_SIZE ) {
+                sendInPtr = 0;
             }
+        } else {
+            printf("EmuSerial: write buffer full\n");
+            break;
         }
-
-        sendCriticalSection.Leave();
     }
 
     return cnt;
@@ -113,8 +97,6 @@ int EmuSerial::read() {
 
     int ch = -1; 
 
-    recvCriticalSection.Enter();
-
     if( recvInPtr != recvOutPtr ) {
         ch = recvBuffer[recvOutPtr++];
         if( recvOutPtr >= EMUSERIAL_BUFFER_SIZE ) {
@@ -122,8 +104,6 @@ int EmuSerial::read() {
         }
     }
 
-    recvCriticalSection.Leave();
-
     return ch;
 }
 
@@ -131,15 +111,11 @@ int EmuSerial::available() {
 
     int available;;
 
-    recvCriticalSection.Enter();
-
     available = recvInPtr - recvOutPtr;
 
     if( recvInPtr < recvOutPtr ) {
         available += EMUSERIAL_BUFFER_SIZE;
     }
 
-    recvCriticalSection.Leave();
-
     return available;
 }
\ No newline at end of file
@@ -27,15 +27,11 @@
 #ifndef _EmuSerial_h_
 #define _EmuSerial_h_
 
-#include <wx/thread.h>
-
 #include "stddef.h"
 #include "Stream.h"
 
 /* The buffer size needs to be big enough to store data for a complete transfer.
- * Currently EmuSerial is called from main thread and SerialConsole is also
- * called from main thread. There is no way to switch between threads 
- * and comsume the buffer content.
+ * The unit test runs in a single thread, so no locking is needed.
  */
 const int EMUSERIAL_BUFFER_SIZE = 10240;
 
@@ -45,13 +41,11 @@ private:
     char sendBuffer[EMUSERIAL_BUFFER_SIZE];
     char recvBuffer[EMUSERIAL_BUFFER_SIZE];
 
-    /* send = emulation to SerialConsole */
-    wxCriticalSection sendCriticalSection;
+    /* send = emulation to console */
     int sendInPtr = 0;
     int sendOutPtr = 0;
 
-    /* recv = SerialConsole to emulation */
-    wxCriticalSection recvCriticalSection;
+    /* recv = console to emulation */
     int recvInPtr = 0;
     int recvOutPtr = 0;
 
@@ -0,0 +1,72 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "string.h"
+#include "LoopbackStream.h"
+
+LoopbackStream::LoopbackStream() {
+
+    clear();
+}
+
+void LoopbackStream::clear() {
+
+    inPtr = 0;
+    outPtr = 0;
+    writeCount = 0;
+}
+
+size_t LoopbackStream::write(const char* text) {
+
+    return write( (const uint8_t*)text, strlen( text));
+}
+
+size_t LoopbackStream::write(const uint8_t *data, size_t size) {
+
+    size_t n = 0;
+
+    writeCount++;
+
+    while( n < size && inPtr < LOOPBACK_BUFFER_SIZE) {
+        buffer[inPtr++] = data[n++];
+    }
+
+    return n;
+}
+
+int LoopbackStream::read() {
+
+    if( outPtr < inPtr) {
+        return buffer[outPtr++];
+    }
+
+    return -1;
+}
+
+int LoopbackStream::available() {
+
+    return inPtr - outPtr;
+}
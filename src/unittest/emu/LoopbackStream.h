@@ -0,0 +1,78 @@
+/*
+  TXos. A remote control transmitter OS.
+
+  MIT License
+
+  Copyright (c) 2023 wlowi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef _LoopbackStream_h_
+#define _LoopbackStream_h_
+
+#include "stddef.h"
+#include "stdint.h"
+#include "Stream.h"
+
+const int LOOPBACK_BUFFER_SIZE = 256;
+
+/* Keeps all bytes written to the stream.
+ * Unit tests inspect them with getData() or read them back with read().
+ * Bytes beyond LOOPBACK_BUFFER_SIZE are dropped.
+ */
+class LoopbackStream : public Stream {
+
+private:
+    uint8_t buffer[LOOPBACK_BUFFER_SIZE];
+    int inPtr = 0;
+    int outPtr = 0;
+    uint16_t writeCount = 0;
+
+public:
+    LoopbackStream();
+
+    /* Discard all data and reset the write counter */
+    void clear();
+
+    /* Bytes written since clear() */
+    const uint8_t *getData() const { return buffer; }
+    int getLength() const { return inPtr; }
+
+    /* Number of write() calls since clear() */
+    uint16_t getWriteCount() const { return writeCount; }
+
+    /* Interface: Stream */
+
+    void setTimeout(unsigned long timeout) {}; // noop
+
+    size_t write(const char* text);
+
+    size_t write(const uint8_t *data, size_t size);
+
+    void flush() {}; // noop
+
+    int read();
+
+    int available();
+
+    void close() {}; // noop 
+};
+
+#endif
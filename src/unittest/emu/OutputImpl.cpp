@@ -47,6 +47,13 @@ void OutputImpl::SetChannelValue(int channel, int value) {
 
 }
 
+void OutputImpl::SetChannelValues( const channelValue_t values[]) {
+
+    for( channel_t ch = 0; ch < PPM_CHANNELS; ch++) {
+        SetChannelValue( ch, values[ch]);
+    }
+}
+
 uint16_t OutputImpl::getOverrunCounter() {
 
     return 0;
@@ -56,3 +63,8 @@ timingUsec_t OutputImpl::getMaxFrameTime() {
 
     return 0;
 }
+
+timingUsec_t OutputImpl::getMinFrameTime() {
+
+    return 0;
+}